@@ -21,6 +21,7 @@ CPP_SRCS += \
 ../src/pc_unit.cpp \
 ../src/sc_functions.cpp \
 ../src/shift_and_add.cpp \
+../src/softsimd_engine.cpp \
 ../src/softsimd_pu.cpp \
 ../src/softsimd_pu_cu_test.cpp \
 ../src/tile_shuffler.cpp 
@@ -43,6 +44,7 @@ CPP_DEPS += \
 ./src/pc_unit.d \
 ./src/sc_functions.d \
 ./src/shift_and_add.d \
+./src/softsimd_engine.d \
 ./src/softsimd_pu.d \
 ./src/softsimd_pu_cu_test.d \
 ./src/tile_shuffler.d 
@@ -65,6 +67,7 @@ OBJS += \
 ./src/pc_unit.o \
 ./src/sc_functions.o \
 ./src/shift_and_add.o \
+./src/softsimd_engine.o \
 ./src/softsimd_pu.o \
 ./src/softsimd_pu_cu_test.o \
 ./src/tile_shuffler.o 
@@ -82,7 +85,7 @@ src/%.o: ../src/%.cpp src/subdir.mk
 clean: clean-src
 
 clean-src:
-	-$(RM) ./src/add_sub.d ./src/add_sub.o ./src/control_plane.d ./src/control_plane.o ./src/control_unit.d ./src/control_unit.o ./src/data_pack.d ./src/data_pack.o ./src/data_pack_synth.d ./src/data_pack_synth.o ./src/imc_pch.d ./src/imc_pch.o ./src/instruction_decoder_mov.d ./src/instruction_decoder_mov.o ./src/instruction_decoder_pack_mask.d ./src/instruction_decoder_pack_mask.o ./src/instruction_decoder_shift_add.d ./src/instruction_decoder_shift_add.o ./src/interface_unit.d ./src/interface_unit.o ./src/mask_unit.d ./src/mask_unit.o ./src/mult_sequencer.d ./src/mult_sequencer.o ./src/opcodes.d ./src/opcodes.o ./src/pack_and_mask.d ./src/pack_and_mask.o ./src/pc_unit.d ./src/pc_unit.o ./src/sc_functions.d ./src/sc_functions.o ./src/shift_and_add.d ./src/shift_and_add.o ./src/softsimd_pu.d ./src/softsimd_pu.o ./src/softsimd_pu_cu_test.d ./src/softsimd_pu_cu_test.o ./src/tile_shuffler.d ./src/tile_shuffler.o
+	-$(RM) ./src/add_sub.d ./src/add_sub.o ./src/control_plane.d ./src/control_plane.o ./src/control_unit.d ./src/control_unit.o ./src/data_pack.d ./src/data_pack.o ./src/data_pack_synth.d ./src/data_pack_synth.o ./src/imc_pch.d ./src/imc_pch.o ./src/instruction_decoder_mov.d ./src/instruction_decoder_mov.o ./src/instruction_decoder_pack_mask.d ./src/instruction_decoder_pack_mask.o ./src/instruction_decoder_shift_add.d ./src/instruction_decoder_shift_add.o ./src/interface_unit.d ./src/interface_unit.o ./src/mask_unit.d ./src/mask_unit.o ./src/mult_sequencer.d ./src/mult_sequencer.o ./src/opcodes.d ./src/opcodes.o ./src/pack_and_mask.d ./src/pack_and_mask.o ./src/pc_unit.d ./src/pc_unit.o ./src/sc_functions.d ./src/sc_functions.o ./src/shift_and_add.d ./src/shift_and_add.o ./src/softsimd_engine.d ./src/softsimd_engine.o ./src/softsimd_pu.d ./src/softsimd_pu.o ./src/softsimd_pu_cu_test.d ./src/softsimd_pu_cu_test.o ./src/tile_shuffler.d ./src/tile_shuffler.o
 
 .PHONY: clean-src
 
@@ -11,6 +11,8 @@ CPP_SRCS += \
 ../src/tb/pch_driver_mixed.cpp \
 ../src/tb/pch_main.cpp \
 ../src/tb/pch_monitor.cpp \
+../src/tb/rshift_driver.cpp \
+../src/tb/rshift_monitor.cpp \
 ../src/tb/softs_driver.cpp \
 ../src/tb/softs_monitor.cpp \
 ../src/tb/softsimd_pu_driver.cpp \
@@ -26,6 +28,8 @@ CPP_DEPS += \
 ./src/tb/pch_driver_mixed.d \
 ./src/tb/pch_main.d \
 ./src/tb/pch_monitor.d \
+./src/tb/rshift_driver.d \
+./src/tb/rshift_monitor.d \
 ./src/tb/softs_driver.d \
 ./src/tb/softs_monitor.d \
 ./src/tb/softsimd_pu_driver.d \
@@ -41,6 +45,8 @@ OBJS += \
 ./src/tb/pch_driver_mixed.o \
 ./src/tb/pch_main.o \
 ./src/tb/pch_monitor.o \
+./src/tb/rshift_driver.o \
+./src/tb/rshift_monitor.o \
 ./src/tb/softs_driver.o \
 ./src/tb/softs_monitor.o \
 ./src/tb/softsimd_pu_driver.o \
@@ -61,7 +67,7 @@ src/tb/%.o: ../src/tb/%.cpp src/tb/subdir.mk
 clean: clean-src-2f-tb
 
 clean-src-2f-tb:
-	-$(RM) ./src/tb/cp_driver.d ./src/tb/cp_driver.o ./src/tb/ms_driver.d ./src/tb/ms_driver.o ./src/tb/ms_monitor.d ./src/tb/ms_monitor.o ./src/tb/pch_driver.d ./src/tb/pch_driver.o ./src/tb/pch_driver_mixed.d ./src/tb/pch_driver_mixed.o ./src/tb/pch_main.d ./src/tb/pch_main.o ./src/tb/pch_monitor.d ./src/tb/pch_monitor.o ./src/tb/softs_driver.d ./src/tb/softs_driver.o ./src/tb/softs_monitor.d ./src/tb/softs_monitor.o ./src/tb/softsimd_pu_driver.d ./src/tb/softsimd_pu_driver.o ./src/tb/softsimd_pu_monitor.d ./src/tb/softsimd_pu_monitor.o ./src/tb/vwr_driver.d ./src/tb/vwr_driver.o ./src/tb/vwr_monitor.d ./src/tb/vwr_monitor.o
+	-$(RM) ./src/tb/cp_driver.d ./src/tb/cp_driver.o ./src/tb/ms_driver.d ./src/tb/ms_driver.o ./src/tb/ms_monitor.d ./src/tb/ms_monitor.o ./src/tb/pch_driver.d ./src/tb/pch_driver.o ./src/tb/pch_driver_mixed.d ./src/tb/pch_driver_mixed.o ./src/tb/pch_main.d ./src/tb/pch_main.o ./src/tb/pch_monitor.d ./src/tb/pch_monitor.o ./src/tb/rshift_driver.d ./src/tb/rshift_driver.o ./src/tb/rshift_monitor.d ./src/tb/rshift_monitor.o ./src/tb/softs_driver.d ./src/tb/softs_driver.o ./src/tb/softs_monitor.d ./src/tb/softs_monitor.o ./src/tb/softsimd_pu_driver.d ./src/tb/softsimd_pu_driver.o ./src/tb/softsimd_pu_monitor.d ./src/tb/softsimd_pu_monitor.o ./src/tb/vwr_driver.d ./src/tb/vwr_driver.o ./src/tb/vwr_monitor.d ./src/tb/vwr_monitor.o
 
 .PHONY: clean-src-2f-tb
 
@@ -1,17 +1,21 @@
 #!/bin/bash
 
-bin/nmc_assembler $INPUTS_DIR/assembly-input/$1.asm $INPUTS_DIR/raw/$1.seq $INPUTS_DIR/data-input/$1.data $INPUTS_DIR/address-input/$1.addr
+# Usage: assembly2sc.sh <name> [<number of pseudo-channels>]
+# With BINARY_TRACES=1, the raw sequence and SystemC inputs are binary instead of text
+NUM_CHANNELS=${2:-1}
+[ "$BINARY_TRACES" = "1" ] && TRACE_FLAG=--binary
 
-bin/raw2ramulator $INPUTS_DIR/raw/$1.seq $INPUTS_DIR/ramulator-in/$1.trace
+bin/nmc_assembler $INPUTS_DIR/assembly-input/$1.asm $INPUTS_DIR/raw/$1.seq $INPUTS_DIR/data-input/$1.data $INPUTS_DIR/address-input/$1.addr $TRACE_FLAG
 
-$RAMULATOR_DIR/ramulator $RAMULATOR_DIR/configs/HBM2_AB-config.cfg --mode=dram $INPUTS_DIR/ramulator-in/$1.trace > $INPUTS_DIR/ramulator-out/$1.cmd
+bin/raw2ramulator $INPUTS_DIR/raw/$1.seq $INPUTS_DIR/ramulator-in/$1.trace
 
-bin/ramulator2sc $INPUTS_DIR/raw/$1.seq $INPUTS_DIR/ramulator-out/$1.cmd $INPUTS_DIR/SystemC/$1.sci 1
+# Ramulator writes the SystemC inputs of every channel, in the format of the raw sequence
+$RAMULATOR_DIR/ramulator $RAMULATOR_DIR/configs/HBM2_AB-config.cfg --mode=dram --sci $INPUTS_DIR/raw/$1.seq $INPUTS_DIR/SystemC/$1.sci $INPUTS_DIR/ramulator-in/$1.trace
 
 cd ..
-Debug/pim-cores $1
+Debug/pim-cores $1 $NUM_CHANNELS
 cd inputs
 
-rm assembly-input/$1.asm address-input/$1.addr data-input/$1.data raw/$1.seq ramulator-in/$1.trace ramulator-out/$1.cmd
+rm assembly-input/$1.asm address-input/$1.addr data-input/$1.data raw/$1.seq ramulator-in/$1.trace
 
 # ./decode_results results/$1.results
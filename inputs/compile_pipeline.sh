@@ -0,0 +1,10 @@
+#!/bin/bash
+
+# In-process pipeline (assembler, Ramulator and SystemC model in one binary).
+# Needs the model built in Debug and Ramulator built in $RAMULATOR_DIR with the files of ramulator_files
+RAMULATOR_OBJS=$(ls $RAMULATOR_DIR/obj/*.o | grep -v "/Main.o$")
+
+g++ -std=c++17 -O2 -DSC_ALLOW_DEPRECATED_IEEE_API -DNMC_ASSEMBLER_LIB -I$SYSTEMC_HOME/include -I$RAMULATOR_DIR/src \
+    src/pim_pipeline.cpp src/ramulator_frontend.cpp src/nmc_assembler.cpp \
+    ../Debug/src/*.o ../Debug/src/microcode/*.o ../Debug/src/tb/pch_driver.o ../Debug/src/tb/pch_monitor.o $RAMULATOR_OBJS \
+    -L$SYSTEMC_HOME/lib -lsystemc -lrt -pthread -o bin/pim_pipeline
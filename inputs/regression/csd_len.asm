@@ -0,0 +1,13 @@
+WRF CSD1 0x0
+WRF CSD_LEN 4
+WRF CSD0 0x100001
+WRF IB0
+RLB AddrFile VWR_0 ALL_WORDS DataFile
+VFUX MUL LEN_8 CSD0 OUT_R3 VWR_0[0]
+NOP 4
+RMV VWR_0[1]
+WLB AddrFile VWR_0 ALL_WORDS
+NOP 0
+
+LOOP 0 0 0
+EXEC
@@ -0,0 +1,248 @@
+; GEMM operation with dimensions 1x64 and 64x16, with initial subword bitwidth = 4, CSD length = 6 and DRAM interval = 1 cycles 
+; Hardware parameters: IB_ENTRIES = 64, CSD_ENTRIES = 32, WORD_BITS = 1536, VWR_BITS = 8192, CORES_PER_PCH = 2
+
+WRF CSD_LEN 6
+
+WRF IB0
+RLB AddrFile VWR_0 ALL_WORDS DataFile
+RLB AddrFile VWR_1 ALL_WORDS DataFile
+VFUX MUL LEN_4 CSD0 OUT_VWR VWR_0[0] VWR_0[0]
+NOP 4
+VFUX MUL LEN_4 CSD1 OUT_VWR VWR_0[1] VWR_0[1]
+NOP 4
+VFUX MUL LEN_4 CSD2 OUT_VWR VWR_0[2] VWR_0[2]
+NOP 4
+VFUX MUL LEN_4 CSD3 OUT_VWR VWR_0[3] VWR_0[3]
+NOP 4
+VFUX MUL LEN_4 CSD4 OUT_VWR VWR_0[4] VWR_0[4]
+NOP 4
+VFUX MUL LEN_4 CSD5 OUT_R3 VWR_1[0]
+NOP 4
+VMV VWR_0[0]
+VFUX ADD LEN_4 SRC_R3 OUT_R1
+PACK CHANGE_4_6 0 OUT_VWR VWR_0[0]
+VFUX MUL LEN_4 CSD6 OUT_R3 VWR_1[1]
+NOP 4
+VMV VWR_0[1]
+VFUX ADD LEN_4 SRC_R3 OUT_R2
+PACK CHANGE_4_6 256 OUT_VWR VWR_1[0]
+PACK CHANGE_4_6 512 OUT_VWR VWR_0[1]
+VFUX MUL LEN_4 CSD7 OUT_R3 VWR_1[2]
+NOP 4
+VMV VWR_0[2]
+VFUX ADD LEN_4 SRC_R3 OUT_R1
+PACK CHANGE_4_6 0 OUT_VWR VWR_1[1]
+VFUX MUL LEN_4 CSD8 OUT_R3 VWR_1[3]
+NOP 4
+VMV VWR_0[3]
+VFUX ADD LEN_4 SRC_R3 OUT_R2
+PACK CHANGE_4_6 256 OUT_VWR VWR_0[2]
+PACK CHANGE_4_6 512 OUT_VWR VWR_1[2]
+VFUX MUL LEN_4 CSD9 OUT_R3 VWR_1[4]
+NOP 4
+VMV VWR_0[4]
+VFUX ADD LEN_4 SRC_R3 OUT_R1
+PACK CHANGE_4_6 0 OUT_VWR VWR_0[3]
+PACK CHANGE_4_6 256 OUT_VWR VWR_1[3]
+VMV VWR_0[0]
+VFUX ADD LEN_6 SRC_VWR OUT_VWR VWR_1[0] VWR_0[0]
+VMV VWR_0[1]
+VFUX ADD LEN_6 SRC_VWR OUT_VWR VWR_1[1] VWR_0[1]
+VMV VWR_0[2]
+VFUX ADD LEN_6 SRC_VWR OUT_VWR VWR_1[2] VWR_0[2]
+WLB AddrFile VWR_0 ALL_WORDS
+WLB AddrFile VWR_1 ALL_WORDS
+NOP 0
+
+LOOP 0 47 1
+
+WRF CSD0 DataFile
+WRF CSD1 DataFile
+WRF CSD2 DataFile
+WRF CSD3 DataFile
+WRF CSD4 DataFile
+WRF CSD5 DataFile
+WRF CSD6 DataFile
+WRF CSD7 DataFile
+WRF CSD8 DataFile
+WRF CSD9 DataFile
+EXEC
+
+WRF CSD0 DataFile
+WRF CSD1 DataFile
+WRF CSD2 DataFile
+WRF CSD3 DataFile
+WRF CSD4 DataFile
+WRF CSD5 DataFile
+WRF CSD6 DataFile
+WRF CSD7 DataFile
+WRF CSD8 DataFile
+WRF CSD9 DataFile
+EXEC
+
+WRF CSD0 DataFile
+WRF CSD1 DataFile
+WRF CSD2 DataFile
+WRF CSD3 DataFile
+WRF CSD4 DataFile
+WRF CSD5 DataFile
+WRF CSD6 DataFile
+WRF CSD7 DataFile
+WRF CSD8 DataFile
+WRF CSD9 DataFile
+EXEC
+
+WRF CSD0 DataFile
+WRF CSD1 DataFile
+WRF CSD2 DataFile
+WRF CSD3 DataFile
+WRF CSD4 DataFile
+WRF CSD5 DataFile
+WRF CSD6 DataFile
+WRF CSD7 DataFile
+WRF CSD8 DataFile
+WRF CSD9 DataFile
+EXEC
+
+WRF CSD0 DataFile
+WRF CSD1 DataFile
+WRF CSD2 DataFile
+WRF CSD3 DataFile
+WRF CSD4 DataFile
+WRF CSD5 DataFile
+WRF CSD6 DataFile
+WRF CSD7 DataFile
+WRF CSD8 DataFile
+WRF CSD9 DataFile
+EXEC
+
+WRF CSD0 DataFile
+WRF CSD1 DataFile
+WRF CSD2 DataFile
+WRF CSD3 DataFile
+WRF CSD4 DataFile
+WRF CSD5 DataFile
+WRF CSD6 DataFile
+WRF CSD7 DataFile
+WRF CSD8 DataFile
+WRF CSD9 DataFile
+EXEC
+
+
+; External loop complete, starting loop peeling
+WRF IB0
+RLB AddrFile VWR_0 ALL_WORDS DataFile
+RLB AddrFile VWR_1 ALL_WORDS DataFile
+VFUX MUL LEN_4 CSD0 OUT_VWR VWR_0[0] VWR_0[0]
+NOP 4
+VFUX MUL LEN_4 CSD1 OUT_VWR VWR_0[1] VWR_0[1]
+NOP 4
+VFUX MUL LEN_4 CSD2 OUT_R3 VWR_1[0]
+NOP 4
+VMV VWR_0[0]
+VFUX ADD LEN_4 SRC_R3 OUT_R1
+PACK CHANGE_4_6 0 OUT_VWR VWR_0[0]
+VFUX MUL LEN_4 CSD3 OUT_R3 VWR_1[1]
+NOP 4
+VMV VWR_0[1]
+VFUX ADD LEN_4 SRC_R3 OUT_R2
+PACK CHANGE_4_6 256 OUT_VWR VWR_1[0]
+PACK CHANGE_4_6 512 OUT_VWR VWR_0[1]
+WLB AddrFile VWR_0 ALL_WORDS
+WLB AddrFile VWR_1 ALL_WORDS
+NOP 0
+
+LOOP 0 18 1
+
+WRF CSD0 DataFile
+WRF CSD1 DataFile
+WRF CSD2 DataFile
+WRF CSD3 DataFile
+EXEC
+
+; Multiplication complete, starting ADD reduction
+WRF IB0
+RLB AddrFile VWR_0 ALL_WORDS DataFile
+RLB AddrFile VWR_1 ALL_WORDS DataFile
+VMV VWR_0[0]
+VFUX ADD LEN_6 SRC_VWR OUT_R1 VWR_1[0]
+PACK CHANGE_6_8 0 OUT_VWR VWR_0[0]
+VMV VWR_0[1]
+VFUX ADD LEN_6 SRC_VWR OUT_R2 VWR_1[1]
+PACK CHANGE_6_8 192 OUT_VWR VWR_1[0]
+VMV VWR_0[2]
+VFUX ADD LEN_6 SRC_VWR OUT_R1 VWR_1[2]
+PACK CHANGE_6_8 384 OUT_VWR VWR_0[1]
+PACK CHANGE_6_8 64 OUT_VWR VWR_1[1]
+VMV VWR_0[3]
+VFUX ADD LEN_6 SRC_VWR OUT_R2 VWR_1[3]
+PACK CHANGE_6_8 256 OUT_VWR VWR_0[2]
+VMV VWR_0[4]
+VFUX ADD LEN_6 SRC_VWR OUT_R1 VWR_1[4]
+PACK CHANGE_6_8 448 OUT_VWR VWR_1[2]
+PACK CHANGE_6_8 128 OUT_VWR VWR_0[3]
+WLB AddrFile VWR_0 ALL_WORDS
+WLB AddrFile VWR_1 ALL_WORDS
+NOP 0
+
+LOOP 0 20 1
+
+EXEC
+EXEC
+
+WRF IB0
+RLB AddrFile VWR_0 ALL_WORDS DataFile
+RLB AddrFile VWR_1 ALL_WORDS DataFile
+VMV VWR_0[0]
+VFUX ADD LEN_8 SRC_VWR OUT_VWR VWR_1[0] VWR_0[0]
+VMV VWR_0[1]
+VFUX ADD LEN_8 SRC_VWR OUT_VWR VWR_1[1] VWR_0[1]
+VMV VWR_0[2]
+VFUX ADD LEN_8 SRC_VWR OUT_VWR VWR_1[2] VWR_0[2]
+VMV VWR_0[3]
+VFUX ADD LEN_8 SRC_VWR OUT_VWR VWR_1[3] VWR_0[3]
+VMV VWR_0[4]
+VFUX ADD LEN_8 SRC_VWR OUT_VWR VWR_1[4] VWR_0[4]
+VMV VWR_0[0]
+VFUX ADD LEN_8 SRC_VWR OUT_R1 VWR_1[0]
+PACK CHANGE_8_12 0 OUT_VWR VWR_0[0]
+VMV VWR_0[1]
+VFUX ADD LEN_8 SRC_VWR OUT_R2 VWR_1[1]
+PACK CHANGE_8_12 128 OUT_VWR VWR_1[0]
+PACK CHANGE_8_12 256 OUT_VWR VWR_0[1]
+VFUX SHIFT 0 LEN_8 SRC_VWR OUT_R1 VWR_1[2]
+PACK CHANGE_8_12 0 OUT_VWR VWR_1[1]
+WLB AddrFile VWR_0 ALL_WORDS
+WLB AddrFile VWR_1 ALL_WORDS
+NOP 0
+
+LOOP 0 23 1
+
+EXEC
+
+WRF IB0
+RLB AddrFile VWR_0 ALL_WORDS DataFile
+RLB AddrFile VWR_1 ALL_WORDS DataFile
+VMV VWR_0[0]
+VFUX ADD LEN_12 SRC_VWR OUT_VWR VWR_1[0] VWR_0[0]
+WLB AddrFile VWR_0 ALL_WORDS
+WLB AddrFile VWR_1 ALL_WORDS
+NOP 0
+
+LOOP 0 5 1
+
+EXEC
+EXEC
+
+; Final ADD reduction, exceeding predicted number of tree layers
+WRF IB0
+RLB AddrFile VWR_0 ALL_WORDS DataFile
+RLB AddrFile VWR_1 ALL_WORDS DataFile
+VMV VWR_0[0]
+VFUX ADD LEN_12 SRC_VWR OUT_VWR VWR_1[0] VWR_0[0]
+WLB AddrFile VWR_0 ALL_WORDS
+NOP 0
+
+LOOP 0 4 1
+
+EXEC
@@ -0,0 +1,14 @@
+WRF CSD0 0x0
+WRF CSD1 0x400000000000
+WRF IB0
+RLB AddrFile VWR_0 ALL_WORDS DataFile
+VFUX MUL LEN_8 CSD1 OUT_R3 VWR_0[0]
+NOP 1
+VFUX MUL LEN_8 CSD0 OUT_R3 VWR_0[0]
+NOP 4
+RMV VWR_0[1]
+WLB AddrFile VWR_0 ALL_WORDS
+NOP 0
+
+LOOP 0 0 0
+EXEC
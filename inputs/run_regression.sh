@@ -0,0 +1,59 @@
+#!/bin/bash
+
+# Usage: run_regression.sh [<case> ...]
+# Runs the programs of regression/ (all of them by default) on the standalone engine, with the
+# bin/ tools built by compile_all.sh, and compares the outputs with the expected ones. The commands
+# are issued 10 cycles apart instead of scheduled by Ramulator, the engine delays the ones that
+# arrive while the PUs are busy. Each case is also run with its PIM RD payloads left in a preload
+# of the banks, and must give the same results. Without cases, the SWAR operations of the engine
+# are also checked against their subword references
+cd "$(dirname "$0")"
+CASES=${@:-$(ls regression/*.asm | xargs -n 1 basename | sed 's/\.asm$//')}
+TMP_DIR=$(mktemp -d)
+FAILED=0
+
+if [ $# -eq 0 ] && ! bin/swar_check; then
+    FAILED=1
+fi
+
+for c in $CASES; do
+    if ! bin/nmc_assembler regression/$c.asm $TMP_DIR/$c.seq regression/$c.data regression/$c.addr > $TMP_DIR/$c.log; then
+        echo "$c: assembler error"
+        FAILED=1
+        continue
+    fi
+    awk '{printf "%d\t%s\n", 1 + 10*NR, $0}' $TMP_DIR/$c.seq > $TMP_DIR/$c.sci
+    if ! bin/softsimd_sim $TMP_DIR/$c.sci $TMP_DIR/$c.results >> $TMP_DIR/$c.log; then
+        echo "$c: simulation error"
+        FAILED=1
+        continue
+    fi
+    if ! bin/nmc_assembler regression/$c.asm $TMP_DIR/$c.pseq regression/$c.data regression/$c.addr --preload=$TMP_DIR/$c.mem >> $TMP_DIR/$c.log; then
+        echo "$c: assembler error with preload"
+        FAILED=1
+        continue
+    fi
+    awk '{printf "%d\t%s\n", 1 + 10*NR, $0}' $TMP_DIR/$c.pseq > $TMP_DIR/$c.psci
+    if ! bin/softsimd_sim $TMP_DIR/$c.psci $TMP_DIR/$c.presults --preload=$TMP_DIR/$c.mem >> $TMP_DIR/$c.log; then
+        echo "$c: simulation error with preload"
+        FAILED=1
+        continue
+    fi
+
+    # Raw sequence and/or PIM WRs, for the cases that give them
+    RESULT=OK
+    for ext in seq results; do
+        if [ -f regression/$c.$ext ] && ! cmp -s regression/$c.$ext $TMP_DIR/$c.$ext; then
+            RESULT="FAILED ($ext differs)"
+            FAILED=1
+        fi
+    done
+    if ! cmp -s $TMP_DIR/$c.results $TMP_DIR/$c.presults; then
+        RESULT="FAILED (results differ with preload)"
+        FAILED=1
+    fi
+    echo "$c: $RESULT"
+done
+
+rm -r $TMP_DIR
+exit $FAILED
@@ -0,0 +1,332 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Design-space exploration of the GEMM kernel over a grid of architecture and
+ * workload parameters. The points run concurrently, each one in its own scratch
+ * directory, through the same flow as assembly2sc_conf.sh. Results are cached
+ * by a hash of the configuration, the workload and the tools used, so that a
+ * repeated sweep only simulates the new points, and all of them are written to
+ * a single CSV file with one column per parameter.
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#include "../../src/trace_cmd.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// Parameters of a point, in the column order of the results file
+enum PARAM {NUM_PU, VWR_BITS, WORD_BITS, IB_ENTRIES, M, N, Q, SW_BW, CSD_LEN, DRAM_INTVL, NUM_PARAMS};
+static const char *PARAM_NAMES[NUM_PARAMS] = {"NUM_PU", "VWR_BITS", "WORD_BITS", "IB_ENTRIES", "M", "N", "Q", "SW_BW", "CSD_LEN", "DRAM_INTVL"};
+
+typedef struct dse_point {
+    uint64_t param[NUM_PARAMS];
+    string name;            // Name of the generated files, unique per point
+    string conf;            // Suffix of the tools built for the architecture
+    uint64_t key;           // Cache key
+    uint64_t cycles;        // Cycle of the last command of channel 0
+    bool cached;            // Taken from the cache, not simulated
+    bool error;
+} dse_point;
+
+// FNV-1a, used for the cache keys
+static uint64_t fnv1a(const void *data, size_t size, uint64_t hash = 0xcbf29ce484222325ULL)
+{
+    const unsigned char *bytes = (const unsigned char *) data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Hash of the contents of a tool, 0 if it does not exist
+static uint64_t file_hash(const string &filename)
+{
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        return 0;
+    }
+    vector<char> buffer(1 << 16);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    while (file.read(buffer.data(), buffer.size()) || file.gcount()) {
+        hash = fnv1a(buffer.data(), file.gcount(), hash);
+    }
+    return hash;
+}
+
+// Comma-separated list of values
+static bool parse_values(const string &list, vector<uint64_t> &values)
+{
+    stringstream ss(list);
+    string value;
+    values.clear();
+    while (getline(ss, value, ',')) {
+        char *end;
+        values.push_back(strtoull(value.c_str(), &end, 10));
+        if (value.empty() || *end) {
+            return false;
+        }
+    }
+    return !values.empty();
+}
+
+static string env(const char *name)
+{
+    const char *value = getenv(name);
+    return value ? value : "";
+}
+
+// Runs a command of the flow, with its output in the log of the point
+static bool run(const string &cmd, const string &log)
+{
+    return system((cmd + " >> " + log + " 2>&1").c_str()) == 0;
+}
+
+// Same steps as assembly2sc_conf.sh, with the files of the tools that do not take
+// their paths (Ramulator statistics, SystemC outputs) kept in the scratch directory
+static void run_point(dse_point &point, const string &scratchDir, const string &ramulatorConfig, bool binary, bool keep, bool check)
+{
+    string inputs = env("INPUTS_DIR"), home = env("SIDEDRAM_HOME"), ramulator = env("RAMULATOR_DIR");
+    string bin = inputs + "/bin/", name = point.name, conf = point.conf;
+    string scratch = scratchDir + "/" + name;
+    string log = scratch + "/log";
+    uint64_t *p = point.param;
+    error_code ec;
+
+    fs::remove_all(scratch, ec);
+    fs::create_directories(scratch, ec);
+    if (ec) {
+        point.error = true;
+        return;
+    }
+
+    string asmFile = inputs + "/assembly-input/" + name + ".asm";
+    string dataFile = inputs + "/data-input/" + name + ".data";
+    string addrFile = inputs + "/address-input/" + name + ".addr";
+    string rawFile = inputs + "/raw/" + name + ".seq";
+    string traceFile = scratch + "/" + name + ".trace";
+    string sciFile = inputs + "/SystemC/" + name + ".sci";
+
+    point.error = !run("cd " + scratch + " && " + bin + "gen_gemm_assembly" + conf + " --m=" + to_string(p[M]) + " --n=" + to_string(p[N]) +
+                    " --q=" + to_string(p[Q]) + " --sw_bw=" + to_string(p[SW_BW]) + " --csd_len=" + to_string(p[CSD_LEN]) +
+                    " --dram_intvl=" + to_string(p[DRAM_INTVL]) + " --output=" + name, log)
+            || !run(bin + "nmc_assembler" + conf + " " + asmFile + " " + rawFile + " " + dataFile + " " + addrFile + (binary ? " --binary" : ""), log)
+            || !run(bin + "raw2ramulator" + conf + " " + rawFile + " " + traceFile, log)
+            || !run(ramulator + "/ramulator " + ramulatorConfig + " --mode=dram --stats " + scratch + "/" + name + ".stats --sci " + rawFile + " " + sciFile + " " + traceFile, log)
+            || !run("cd " + scratch + " && " + home + "/Debug/pim-cores" + conf + " " + name, log);
+
+    // Words written by the kernel against the golden reference, with the sizes of the architecture
+    if (!point.error && check) {
+        point.error = !run(bin + "golden_check " + asmFile + " " + dataFile + " " + addrFile + " " + inputs + "/results/" + name + ".results" +
+                " --CORES_PER_PCH=" + to_string(p[NUM_PU]) + " --IB_ENTRIES=" + to_string(p[IB_ENTRIES]) +
+                " --VWR_BITS=" + to_string(p[VWR_BITS]) + " --WORD_BITS=" + to_string(p[WORD_BITS]), log);
+    }
+
+    // Cycle of the last command of channel 0, as in the exploration scripts
+    if (!point.error) {
+        unique_ptr<trace_source> sci = open_trace_source(sciFile + "0", true);
+        trace_view cmd;
+        point.cycles = 0;
+        point.error = !sci;
+        while (sci && sci->next_view(cmd)) {
+            point.cycles = cmd.cycle;
+        }
+    }
+
+    // Inputs of all the channels are removed, the scratch directory only if the point succeeded
+    fs::remove(asmFile, ec);
+    fs::remove(dataFile, ec);
+    fs::remove(addrFile, ec);
+    fs::remove(rawFile, ec);
+    for (uint c = 0; fs::remove(sciFile + to_string(c), ec); c++);
+    if (!point.error && !keep) {
+        fs::remove_all(scratch, ec);
+    }
+}
+
+int main(int argc, const char *argv[])
+{
+    // Defaults of base_exploration.sh, SideDRAM-384B
+    vector<uint64_t> grid[NUM_PARAMS] = {{2}, {8192}, {1536}, {64}, {1}, {64}, {64, 256, 1024, 4096}, {3, 4, 6, 8, 12, 16, 24}, {8}, {5}};
+    uint numJobs = thread::hardware_concurrency();
+    string results, cacheFile, scratchDir;
+    string ramulatorConfig = env("RAMULATOR_DIR") + "/configs/HBM2_AB-config.cfg";
+    bool binary = (env("BINARY_TRACES") == "1"), keep = false, check = false, usage = false;
+    int i, p;
+
+    for (i = 1; i < argc; i++) {
+        string arg = argv[i];
+        for (p = 0; p < NUM_PARAMS; p++) {
+            string option = string("--") + PARAM_NAMES[p] + "=";
+            if (arg.find(option) == 0) {
+                if (!parse_values(arg.substr(option.size()), grid[p])) {
+                    cout << "Error: bad list of values in " << arg << endl;
+                    return 1;
+                }
+                break;
+            }
+        }
+        if (p < NUM_PARAMS) {
+            continue;
+        }
+        if (arg.find("--jobs=") == 0) {
+            numJobs = atoi(arg.substr(7).c_str());
+        } else if (arg.find("--cache=") == 0) {
+            cacheFile = arg.substr(8);
+        } else if (arg.find("--scratch=") == 0) {
+            scratchDir = arg.substr(10);
+        } else if (arg.find("--ramulator-config=") == 0) {
+            ramulatorConfig = arg.substr(19);
+        } else if (arg == "--keep") {
+            keep = true;
+        } else if (arg == "--check") {
+            check = true;
+        } else if (results.empty() && arg.find("--") != 0) {
+            results = arg;
+        } else {
+            usage = true;
+        }
+    }
+
+    if (usage || results.empty() || env("INPUTS_DIR").empty()) {
+        cout << "Usage: " << argv[0] << " <results csv> [--<PARAM>=<v1>,<v2>,...] [--jobs=<J>] [--cache=<file>] [--scratch=<dir>]"
+                " [--ramulator-config=<file>] [--keep] [--check]" << endl;
+        cout << "       PARAM is one of";
+        for (p = 0; p < NUM_PARAMS; p++) {
+            cout << " " << PARAM_NAMES[p];
+        }
+        cout << endl << "       The paths of export_paths.sh must be set, and the tools of every architecture built with compile_all_conf.sh" << endl;
+        return usage ? 1 : 0;
+    }
+    if (cacheFile.empty()) {
+        cacheFile = env("SIDEDRAM_HOME") + "/stats/dse_cache.txt";
+    }
+    if (scratchDir.empty()) {
+        scratchDir = env("INPUTS_DIR") + "/dse-scratch";
+    }
+
+    // Cartesian product of the grid, skipping words wider than the VWRs
+    vector<dse_point> points;
+    vector<size_t> idx(NUM_PARAMS, 0);
+    bool done = false;
+    while (!done) {
+        dse_point point = {};
+        for (p = 0; p < NUM_PARAMS; p++) {
+            point.param[p] = grid[p][idx[p]];
+        }
+        if (point.param[WORD_BITS] <= point.param[VWR_BITS]) {
+            points.push_back(point);
+        }
+        for (p = NUM_PARAMS - 1; p >= 0 && ++idx[p] == grid[p].size(); p--) {
+            idx[p] = 0;
+        }
+        done = (p < 0);
+    }
+
+    // Tools of each architecture, hashed once, with the Ramulator binary and configuration
+    map<string, uint64_t> toolHash;
+    uint64_t ramulatorHash[] = {file_hash(env("RAMULATOR_DIR") + "/ramulator"), file_hash(ramulatorConfig)};
+    for (dse_point &point : points) {
+        uint64_t *prm = point.param;
+        point.conf = "_PU" + to_string(prm[NUM_PU]) + "_IB" + to_string(prm[IB_ENTRIES]) + "_VWR" + to_string(prm[VWR_BITS]) + "_WORD" + to_string(prm[WORD_BITS]);
+        point.name = "gemm_m" + to_string(prm[M]) + "_n" + to_string(prm[N]) + "_q" + to_string(prm[Q]) + "_SW" + to_string(prm[SW_BW]) +
+                "_CSD" + to_string(prm[CSD_LEN]) + "_I" + to_string(prm[DRAM_INTVL]) + point.conf;
+        if (!toolHash.count(point.conf)) {
+            string bin = env("INPUTS_DIR") + "/bin/";
+            uint64_t tools[] = {file_hash(bin + "gen_gemm_assembly" + point.conf), file_hash(bin + "nmc_assembler" + point.conf),
+                                file_hash(bin + "raw2ramulator" + point.conf), file_hash(env("SIDEDRAM_HOME") + "/Debug/pim-cores" + point.conf)};
+            toolHash[point.conf] = fnv1a(tools, sizeof(tools), fnv1a(ramulatorHash, sizeof(ramulatorHash)));
+        }
+        point.key = fnv1a(point.param, sizeof(point.param), toolHash[point.conf]);
+    }
+
+    // Cached results, one "<key> <cycles>" line per point
+    map<uint64_t, uint64_t> cache;
+    ifstream cacheIn(cacheFile);
+    uint64_t key, cycles;
+    while (cacheIn >> hex >> key >> dec >> cycles) {
+        cache[key] = cycles;
+    }
+    cacheIn.close();
+
+    vector<dse_point *> pending;
+    for (dse_point &point : points) {
+        auto cached = cache.find(point.key);
+        if (cached != cache.end()) {
+            point.cycles = cached->second;
+            point.cached = true;
+        } else {
+            pending.push_back(&point);
+        }
+    }
+    cout << points.size() << " points, " << points.size() - pending.size() << " cached, " << pending.size() << " to simulate with "
+            << max(1u, numJobs) << " jobs" << endl;
+
+    // Each job takes the next point, finished points are added to the cache right away
+    ofstream cacheOut(cacheFile, ios::app);
+    mutex cacheMutex;
+    vector<thread> workers;
+    atomic<size_t> nextPoint(0);
+    numJobs = max(1u, (uint) min<size_t>(numJobs, pending.size()));
+    for (uint t = 0; t < numJobs && !pending.empty(); t++) {
+        workers.emplace_back([&]() {
+            size_t n;
+            while ((n = nextPoint++) < pending.size()) {
+                dse_point &point = *pending[n];
+                run_point(point, scratchDir, ramulatorConfig, binary, keep, check);
+                lock_guard<mutex> lock(cacheMutex);
+                if (point.error) {
+                    cout << "Error: " << point.name << " failed, see " << scratchDir << "/" << point.name << "/log" << endl;
+                } else {
+                    cacheOut << hex << point.key << " " << dec << point.cycles << endl;
+                    cout << point.name << ": " << point.cycles << " cycles" << endl;
+                }
+            }
+        });
+    }
+    for (thread &w : workers) {
+        w.join();
+    }
+
+    // All the points of the grid, in grid order
+    ofstream output(results);
+    if (!output.is_open()) {
+        cout << "Error when opening results file " << results << endl;
+        return 1;
+    }
+    bool error = false;
+    for (p = 0; p < NUM_PARAMS; p++) {
+        output << PARAM_NAMES[p] << ",";
+    }
+    output << "CYCLES" << endl;
+    for (dse_point &point : points) {
+        for (p = 0; p < NUM_PARAMS; p++) {
+            output << point.param[p] << ",";
+        }
+        if (!point.error) {
+            output << point.cycles;
+        }
+        output << endl;
+        error |= point.error;
+    }
+    cout << "Results saved in " << results << endl;
+
+    return error ? 1 : 0;
+}
@@ -0,0 +1,445 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Cycle model of the GEMM mappings of gen_gemm_assembly, to explore a design
+ * space without running Ramulator or the SystemC model. The program of each
+ * point is mapped in memory, without its data, and the DRAM commands it sends
+ * (programming writes, and one command per executed instruction) are counted
+ * by row hits, row misses and read/write turnarounds. The cycles are the sum
+ * of the HBM2_AB timing constraints of those transitions, plus refreshes.
+ * Against simulated points (the CSV of dse_runner), it reports the prediction
+ * error and a linear calibration of the model.
+ * The model has not been validated yet against simulated points, its cycles
+ * are only meant to rank the architectures of a workload.
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "../../src/defs.h"
+#include "../../src/arch_config.h"
+#include "../../src/opcodes.h"
+#include "map_gemm.h"
+
+using namespace std;
+
+// Timings of HBM2_AB at HBM2_300MHz (configs/HBM2_AB-config.cfg), in memory cycles
+typedef struct dram_timing {
+    uint nBL, nCCDL, nCL, nRCD, nRP, nCWL, nRAS, nRC, nRTP, nWTRL, nWR, nRFC, nREFI;
+} dram_timing;
+static const dram_timing HBM2_AB_300MHZ = {1, 3, 5, 5, 5, 2, 11, 15, 3, 3, 5, 78, 1170};
+
+// Parameters of a point, same columns as the results of dse_runner
+enum PARAM {NUM_PU, VWR_BITS_P, WORD_BITS_P, IB_ENTRIES_P, M, N, Q, SW_BW, CSD_LEN, DRAM_INTVL, NUM_PARAMS};
+static const char *PARAM_NAMES[NUM_PARAMS] = {"NUM_PU", "VWR_BITS", "WORD_BITS", "IB_ENTRIES", "M", "N", "Q", "SW_BW", "CSD_LEN", "DRAM_INTVL"};
+
+typedef struct gemm_estimate {
+    uint64_t commands;      // RD and WR commands sent to the DRAM
+    uint64_t writes;        // WR commands, the programming ones included
+    uint64_t activations;   // Row misses, each one a PRE and an ACT
+    uint64_t turnarounds;   // RD to WR and WR to RD changes
+    uint64_t cycles;        // Cycle of the last command
+} gemm_estimate;
+
+// Command stream through an open-row bank, issued in order as soon as the timing allows
+class dram_replay {
+public:
+    gemm_estimate est = {0, 0, 0, 0, 0};
+
+    dram_replay(const dram_timing &t_) : t(t_) {}
+
+    void command(uint64_t row, bool wr) {
+        uint64_t col = 0;
+        if (!est.commands || row != openRow) {
+            uint64_t act = 0;
+            if (est.commands) {
+                uint64_t pre = max(lastAct + t.nRAS, lastCol + (lastWr ? t.nCWL + t.nBL + t.nWR : t.nRTP));
+                act = max(pre + t.nRP, lastAct + t.nRC);
+            }
+            lastAct = act;
+            openRow = row;
+            col = act + t.nRCD;
+            est.activations++;
+        }
+        if (est.commands) {
+            uint64_t cas = t.nCCDL;
+            if (wr != lastWr) {
+                cas = wr ? t.nCL + t.nCCDL + 2 - t.nCWL : t.nCWL + t.nBL + t.nWTRL;
+                est.turnarounds++;
+            }
+            col = max(col, lastCol + cas);
+        }
+        lastCol = col;
+        lastWr = wr;
+        est.commands++;
+        est.writes += wr;
+    }
+
+    // Cycles with the refreshes that fall in them, each one closing the open row
+    gemm_estimate finish() {
+        uint64_t refreshes = lastCol / (t.nREFI - t.nRFC - t.nRP - t.nRCD);
+        est.cycles = lastCol + refreshes * (t.nRFC + t.nRP + t.nRCD);
+        est.activations += refreshes;
+        return est;
+    }
+
+private:
+    const dram_timing &t;
+    uint64_t openRow = 0;
+    uint64_t lastAct = 0, lastCol = 0;
+    bool lastWr = false;
+};
+
+// Row of a DRAM address, the programming rows in the upper half
+static uint64_t addr_row(uint64_t addr) {
+    return (addr >> (GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS + BANK_BITS)) & ((1 << ROW_BITS) - 1);
+}
+
+static uint64_t rf_row(const arch_config &arch, RF_SEL rf, uint64_t idx) {
+    return ((((uint64_t) rf << arch.rf_addr_bits()) + idx) >> COL_BITS) | (1 << (ROW_BITS - 1));
+}
+
+// Instruction kept in the IB, only what decides its DRAM command
+typedef struct ib_instr {
+    bool rd, wr;    // RLB and WLB, with their address from the address file
+    bool exit;      // NOP 0
+} ib_instr;
+
+// Runs the assembly program as nmc_assembler would lay it out in DRAM commands
+static bool replay_program(const arch_config &arch, istream &assembly, istream &addrFile, dram_replay &dram)
+{
+    vector<ib_instr> ib(arch.ib_entries, {false, false, false});
+    uint64_t ibIdx = 0, loopStart = 0, loopEnd = 0, loopNumIter = 0, addr;
+    uint64_t lastRow = 0;
+    bool ibWrMode = false;
+    string line, instr, store;
+
+    while (getline(assembly, line)) {
+        istringstream is(line);
+        if (line.empty() || line[0] == ';' || !(is >> instr)) {
+            continue;
+        }
+
+        if (instr == "WRF") {
+            is >> store;
+            size_t digits = store.find_first_of("0123456789");
+            string rf = store.substr(0, digits);
+            uint64_t idx = (digits == string::npos) ? 0 : stoull(store.substr(digits));
+            if (rf == "IB") {
+                ibWrMode = true;
+                ibIdx = idx;
+            } else {
+                RF_SEL sel = (rf == "CSD") ? RF_SEL::CSDRF : (rf == "CSD_LEN") ? RF_SEL::CSD_LEN : (rf == "SRF") ? RF_SEL::SRF : RF_SEL::MRF;
+                dram.command(rf_row(arch, sel, idx), true);
+            }
+
+        } else if (instr == "LOOP") {
+            is >> loopStart >> loopEnd >> loopNumIter;
+            dram.command(rf_row(arch, RF_SEL::LOOP_REG, 0), true);
+
+        } else if (instr == "EXEC") {
+            uint64_t execIdx = 0, loopCurrIter = 0;
+            lastRow = 0;
+            ibWrMode = false;
+            for (;;) {
+                const ib_instr &cur = ib[execIdx];
+                if (cur.rd || cur.wr) {
+                    if (!(addrFile >> hex >> addr)) {
+                        cout << "Error, address file cannot be read" << endl;
+                        return false;
+                    }
+                    lastRow = addr_row(addr);
+                }
+                dram.command(lastRow, cur.wr);
+
+                if (cur.exit) {
+                    break;
+                } else if (loopNumIter && execIdx == loopEnd && loopCurrIter < loopNumIter - 1) {
+                    loopCurrIter++;
+                    execIdx = loopStart;
+                } else if (++execIdx >= arch.ib_entries) {
+                    break;
+                }
+            }
+
+        } else if (ibWrMode && ibIdx < arch.ib_entries) {
+            uint64_t imm = 1;
+            if (instr == "NOP") {
+                is >> imm;
+            }
+            ib[ibIdx] = {instr == "RLB", instr == "WLB", instr == "NOP" && !imm};
+            dram.command(rf_row(arch, RF_SEL::IB, ibIdx), true);
+            ibIdx++;
+
+        } else {
+            cout << "Error, unexpected instruction " << instr << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Maps the GEMM of a point and replays its commands
+static bool estimate(const uint64_t *p, gemm_estimate &est)
+{
+    arch_config arch;
+    arch.set("CORES_PER_PCH", p[NUM_PU]);
+    arch.set("VWR_BITS", p[VWR_BITS_P]);
+    arch.set("DRAM_BITS", p[VWR_BITS_P]);
+    arch.set("WORD_BITS", p[WORD_BITS_P]);
+    arch.set("IB_ENTRIES", p[IB_ENTRIES_P]);
+    arch.set("CSD_ENTRIES", p[IB_ENTRIES_P] / 2);   // As in the exploration scripts
+    if (!arch.check(cout)) {
+        return false;
+    }
+
+    stringstream assembly, addrFile;
+    ostream noData(NULL);
+    mt19937 gen(0);
+    map_gemm(arch, assembly, noData, addrFile, p[M], p[N], p[Q], p[SW_BW], p[CSD_LEN], p[DRAM_INTVL], false, gen);
+
+    dram_replay dram(HBM2_AB_300MHZ);
+    if (!replay_program(arch, assembly, addrFile, dram)) {
+        return false;
+    }
+    est = dram.finish();
+    return true;
+}
+
+// Comma-separated list of values
+static bool parse_values(const string &list, vector<uint64_t> &values)
+{
+    stringstream ss(list);
+    string value;
+    values.clear();
+    while (getline(ss, value, ',')) {
+        char *end;
+        values.push_back(strtoull(value.c_str(), &end, 10));
+        if (value.empty() || *end) {
+            return false;
+        }
+    }
+    return !values.empty();
+}
+
+typedef struct model_point {
+    uint64_t param[NUM_PARAMS];
+    gemm_estimate est;
+    double simulated;       // CYCLES of the results file, negative if there is none
+    bool error;
+} model_point;
+
+// Points of a results file of dse_runner, with their simulated cycles
+static bool read_results(const string &filename, vector<model_point> &points)
+{
+    ifstream input(filename);
+    string line, field;
+    if (!input.is_open() || !getline(input, line)) {
+        cout << "Error when opening results file " << filename << endl;
+        return false;
+    }
+    while (getline(input, line)) {
+        stringstream ss(line);
+        model_point point = {};
+        int p;
+        for (p = 0; p < NUM_PARAMS && getline(ss, field, ','); p++) {
+            point.param[p] = strtoull(field.c_str(), NULL, 10);
+        }
+        if (p < NUM_PARAMS) {
+            continue;
+        }
+        point.simulated = (getline(ss, field, ',') && !field.empty()) ? strtod(field.c_str(), NULL) : -1;
+        points.push_back(point);
+    }
+    return true;
+}
+
+int main(int argc, const char *argv[])
+{
+    // Defaults of base_exploration.sh, SideDRAM-384B
+    vector<uint64_t> grid[NUM_PARAMS] = {{2}, {8192}, {1536}, {64}, {1}, {64}, {64, 256, 1024, 4096}, {3, 4, 6, 8, 12, 16, 24}, {8}, {5}};
+    string output, validate;
+    uint best = 0, numThreads = thread::hardware_concurrency();
+    bool usage = false;
+    int i, p;
+
+    for (i = 1; i < argc; i++) {
+        string arg = argv[i];
+        for (p = 0; p < NUM_PARAMS; p++) {
+            string option = string("--") + PARAM_NAMES[p] + "=";
+            if (arg.find(option) == 0) {
+                if (!parse_values(arg.substr(option.size()), grid[p])) {
+                    cout << "Error: bad list of values in " << arg << endl;
+                    return 1;
+                }
+                break;
+            }
+        }
+        if (p < NUM_PARAMS) {
+            continue;
+        }
+        if (arg.find("--validate=") == 0) {
+            validate = arg.substr(11);
+        } else if (arg.find("--best=") == 0) {
+            best = atoi(arg.substr(7).c_str());
+        } else if (arg.find("--threads=") == 0) {
+            numThreads = atoi(arg.substr(10).c_str());
+        } else if (output.empty() && arg.find("--") != 0) {
+            output = arg;
+        } else {
+            usage = true;
+        }
+    }
+
+    if (usage || output.empty()) {
+        cout << "Usage: " << argv[0] << " <output csv> [--<PARAM>=<v1>,<v2>,...] [--best=<K>] [--threads=<T>]" << endl;
+        cout << "       " << argv[0] << " <output csv> --validate=<dse_runner results csv>" << endl;
+        cout << "       PARAM is one of";
+        for (p = 0; p < NUM_PARAMS; p++) {
+            cout << " " << PARAM_NAMES[p];
+        }
+        cout << endl << "       --best=<K> keeps the K architectures with the fewest predicted cycles for each workload" << endl;
+        cout << "       The model is not validated: run --validate on simulated points before trusting its cycles" << endl;
+        return usage ? 1 : 0;
+    }
+
+    // Points of the grid, or of the simulated results
+    vector<model_point> points;
+    if (!validate.empty()) {
+        if (!read_results(validate, points)) {
+            return 1;
+        }
+    } else {
+        vector<size_t> idx(NUM_PARAMS, 0);
+        bool done = false;
+        while (!done) {
+            model_point point = {};
+            for (p = 0; p < NUM_PARAMS; p++) {
+                point.param[p] = grid[p][idx[p]];
+            }
+            point.simulated = -1;
+            if (point.param[WORD_BITS_P] <= point.param[VWR_BITS_P]) {
+                points.push_back(point);
+            }
+            for (p = NUM_PARAMS - 1; p >= 0 && ++idx[p] == grid[p].size(); p--) {
+                idx[p] = 0;
+            }
+            done = (p < 0);
+        }
+    }
+
+    // The points are independent, each thread takes the next one
+    vector<thread> workers;
+    atomic<size_t> nextPoint(0);
+    numThreads = max(1u, (uint) min<size_t>(numThreads, points.size()));
+    for (uint t = 0; t < numThreads; t++) {
+        workers.emplace_back([&]() {
+            size_t n;
+            while ((n = nextPoint++) < points.size()) {
+                points[n].error = !estimate(points[n].param, points[n].est);
+            }
+        });
+    }
+    for (thread &w : workers) {
+        w.join();
+    }
+
+    // Only the best architectures of each workload (M, N, Q, SW_BW, CSD_LEN, DRAM_INTVL)
+    if (best) {
+        map<vector<uint64_t>, vector<model_point *> > workloads;
+        for (model_point &point : points) {
+            if (!point.error) {
+                workloads[vector<uint64_t>(point.param + M, point.param + NUM_PARAMS)].push_back(&point);
+            }
+        }
+        vector<model_point> kept;
+        for (auto &workload : workloads) {
+            vector<model_point *> &archs = workload.second;
+            stable_sort(archs.begin(), archs.end(), [](const model_point *a, const model_point *b) { return a->est.cycles < b->est.cycles; });
+            for (size_t k = 0; k < min<size_t>(best, archs.size()); k++) {
+                kept.push_back(*archs[k]);
+            }
+        }
+        cout << "Kept " << kept.size() << " of " << points.size() << " points" << endl;
+        points = kept;
+    }
+
+    ofstream csv(output);
+    if (!csv.is_open()) {
+        cout << "Error when opening output file " << output << endl;
+        return 1;
+    }
+    for (p = 0; p < NUM_PARAMS; p++) {
+        csv << PARAM_NAMES[p] << ",";
+    }
+    csv << "COMMANDS,WRITES,ACTIVATIONS,TURNAROUNDS,PREDICTED" << (validate.empty() ? "" : ",CYCLES,ERROR") << endl;
+
+    // Prediction error against the simulated points, and least squares of CYCLES = a * PREDICTED + b
+    double sumErr = 0, maxErr = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    uint64_t compared = 0, failed = 0;
+    for (model_point &point : points) {
+        failed += point.error;
+        for (p = 0; p < NUM_PARAMS; p++) {
+            csv << point.param[p] << ",";
+        }
+        if (!point.error) {
+            csv << point.est.commands << "," << point.est.writes << "," << point.est.activations << "," << point.est.turnarounds << "," << point.est.cycles;
+        } else {
+            csv << ",,,,";
+        }
+        if (!validate.empty()) {
+            csv << ",";
+            if (point.simulated > 0) {
+                csv << uint64_t(point.simulated);
+            }
+            csv << ",";
+            if (point.simulated > 0 && !point.error) {
+                double x = point.est.cycles, y = point.simulated, err = (x - y) / y;
+                csv << fixed << setprecision(4) << err << defaultfloat;
+                sumErr += fabs(err);
+                maxErr = max(maxErr, fabs(err));
+                sx += x; sy += y; sxx += x * x; sxy += x * y;
+                compared++;
+            }
+        }
+        csv << endl;
+    }
+
+    cout << points.size() - failed << " points predicted";
+    if (failed) {
+        cout << ", " << failed << " could not be mapped";
+    }
+    cout << ", saved in " << output << endl;
+    if (compared) {
+        cout << "Against " << compared << " simulated points: mean absolute error " << fixed << setprecision(2) << 100 * sumErr / compared
+                << "%, maximum " << 100 * maxErr << "%" << endl;
+        double den = compared * sxx - sx * sx;
+        if (compared > 1 && den != 0) {
+            double a = (compared * sxy - sx * sy) / den, b = (sy - a * sx) / compared;
+            double calErr = 0;
+            for (model_point &point : points) {
+                if (point.simulated > 0 && !point.error) {
+                    calErr += fabs((a * point.est.cycles + b - point.simulated) / point.simulated);
+                }
+            }
+            cout << "Calibrated as CYCLES = " << setprecision(4) << a << " * PREDICTED + " << setprecision(1) << b
+                    << ": mean absolute error " << setprecision(2) << 100 * calErr / compared << "%" << endl;
+        }
+    }
+
+    return failed ? 1 : 0;
+}
@@ -1,4 +1,5 @@
 #include "gen_gemm_assembly.h"
+#include "map_gemm.h"
 
 /*** This program generates assembly files for the SoftSIMD-near-DRAM system
  *   that correspond with the execution of GEMM operation of configurable dimensions.
@@ -23,7 +24,8 @@ void parse_args (int argc, char **argv, int &m, int &n, int &q, int &sw_bw, int
     // Check if the number of arguments is correct
     if (argc < 7) {
         std::cerr << "Usage: " << argv[0];
-        std::cerr << " --m=<m> --n=<n> --q=<q> --sw_bw=<sw_bw> --csd_len=<csd_len> --dram_intvl=<dram_intvl> --output=<output> [-v]" << std::endl;
+        std::cerr << " --m=<m> --n=<n> --q=<q> --sw_bw=<sw_bw> --csd_len=<csd_len> --dram_intvl=<dram_intvl> --output=<output> [-v]";
+        std::cerr << " [--config=<file>] [--<PARAM>=<value>]" << std::endl;
         exit(1);
     }
 
@@ -88,25 +90,30 @@ uint64_t generate_random_csd(uint csd_len, std::mt19937 &gen) {
 
 /**
  * Function to write a random VWR to the data file
+ * @param arch Architecture configuration
  * @param sw_bw Bitwidth of the subword operands
- * @param dataFile Output stream for the data file
+ * @param dataFile Output stream for the data file, nothing is generated if it is not good
  * @param gen Random number generator
  */
-void write_random_vwr (uint sw_bw, std::ofstream &dataFile, std::mt19937 &gen) {
-    uint64_t vwr[VWR_64B];
+void write_random_vwr (const arch_config &arch, uint sw_bw, std::ostream &dataFile, std::mt19937 &gen) {
+    std::vector<uint64_t> vwr(arch.vwr_64b());
     uint64_t subword;
 
+    if (!dataFile.good()) { // Data not needed (cycle model), skip generating it
+        return;
+    }
+
     if (!sw_bw) {
         std::cerr << "Subword bitwidth cannot be zero" << std::endl;
         exit(1);
     }
 
     std::uniform_int_distribution<uint64_t> dis(0, (1 << (sw_bw-1)) - 1);
-    for (uint c = 0; c < CORES_PER_PCH; c++) {
-        for (uint i = 0; i < VWR_64B; i++) {
+    for (uint c = 0; c < arch.cores_per_pch; c++) {
+        for (uint i = 0; i < arch.vwr_64b(); i++) {
             vwr[i] = 0;
         }
-        for (uint i = 0; i < WORDS_PER_VWR*WORD_BITS/sw_bw; i++) {
+        for (uint i = 0; i < arch.words_per_vwr()*arch.word_bits/sw_bw; i++) {
             subword = dis(gen);
             subword |= (subword & (1 << (sw_bw-2))) << 1;   // Duplicate the sign bit
             if (((i + 1) * sw_bw - 1) % 64 >= sw_bw) {  // Complete subword in 64-bit word
@@ -116,7 +123,7 @@ void write_random_vwr (uint sw_bw, std::ofstream &dataFile, std::mt19937 &gen) {
                 vwr[(i*sw_bw)/64 + 1] |= subword >> (64 - ((i*sw_bw) % 64));
             }
         }
-        for (uint i = 0; i < VWR_64B; i++) {    // @NOTE check if this is the correct write order, or if it should be reversed
+        for (uint i = 0; i < arch.vwr_64b(); i++) {    // @NOTE check if this is the correct write order, or if it should be reversed
             dataFile << std::showbase << std::hex << vwr[i] << "\t";
         }
     }
@@ -150,6 +157,7 @@ uint64_t nxt_addr(uint64_t chIdx, uint64_t &roIdx, uint64_t &coIdx)
 
 /** 
  * Function to initialize the add tree vector with the necessary layers
+ * @param arch Architecture configuration
  * @param addTreeVector Vector to store the add tree layers
  * @param addTreeLayerTotal Total number of layers in the add tree
  * @param addTreeInputsPerDP Number of inputs to the add tree to compute dot product
@@ -157,7 +165,7 @@ uint64_t nxt_addr(uint64_t chIdx, uint64_t &roIdx, uint64_t &coIdx)
  * @param q Horizontal dimension of the B matrix
  * @param verbose Flag to enable verbose output
  */
-void initiallizeAddTreeVector (std::vector<addTreeLayer> &addTreeVector, uint addTreeLayerTotal,
+void initiallizeAddTreeVector (const arch_config &arch, std::vector<addTreeLayer> &addTreeVector, uint addTreeLayerTotal,
                                 uint addTreeInputsPerDP, uint sw_bw_0, uint q, bool verbose) {
     // Initialize the add tree vector
     for (uint i = 0; i < addTreeLayerTotal; i++) {
@@ -167,8 +175,8 @@ void initiallizeAddTreeVector (std::vector<addTreeLayer> &addTreeVector, uint ad
         addTreeLayer.outputs = div_ceil(addTreeLayer.inputs, 2);
         addTreeLayer.additions = addTreeLayer.inputs / 2;
         addTreeLayer.ADDOps = (i == 0) ? 
-                            div_ceil(q, (WORD_BITS * CORES_PER_PCH / sw_bw_0)) * addTreeLayer.additions : 
-                            div_ceil(q, (WORD_BITS * CORES_PER_PCH / swsize_to_uint(addTreeVector[i-1].sw_out))) * addTreeLayer.additions;
+                            div_ceil(q, (arch.word_bits * arch.cores_per_pch / sw_bw_0)) * addTreeLayer.additions : 
+                            div_ceil(q, (arch.word_bits * arch.cores_per_pch / swsize_to_uint(addTreeVector[i-1].sw_out))) * addTreeLayer.additions;
         if (i == 0) {
             addTreeLayer.sw_in = uint_to_swsize(sw_bw_0);
             addTreeLayer.sw_out = next_sw(addTreeLayer.sw_in);
@@ -195,7 +203,7 @@ void initiallizeAddTreeVector (std::vector<addTreeLayer> &addTreeVector, uint ad
         addTreeLayer.sw_change = repack_sw(addTreeLayer.sw_in, addTreeLayer.sw_out);
         addTreeLayer.PACKOps = (addTreeLayer.sw_change == SWREPACK::INV) ? 
                                 0 :
-                                div_ceil(q, (WORD_BITS * CORES_PER_PCH / swsize_to_uint(addTreeLayer.sw_out)) * addTreeLayer.outputs);
+                                div_ceil(q, (arch.word_bits * arch.cores_per_pch / swsize_to_uint(addTreeLayer.sw_out)) * addTreeLayer.outputs);
 
         addTreeVector.push_back(addTreeLayer);
 
@@ -211,6 +219,7 @@ void initiallizeAddTreeVector (std::vector<addTreeLayer> &addTreeVector, uint ad
 
 /**
  * Function to generate the assembly code for the ADD reduction operation within a code chunk.
+ * @param arch Architecture configuration
  * @param curAddLayer Current layer of the ADD tree
  * @param curInstrCount Current instruction count
  * @param numSw Total number of subwords in the reduction layer at the VWR
@@ -221,8 +230,8 @@ void initiallizeAddTreeVector (std::vector<addTreeLayer> &addTreeVector, uint ad
  * @param limitLayer Layer to stop the reduction (if 0, reduction continues until possible)
  * @param verbose Flag to enable verbose output
  */
-void generate_add_reduction_assembly (uint &curAddLayer, uint &curInstrCount, uint &numSw, uint originalSwPerWord, uint addTreeLayerTotal,
-                                    std::vector<addTreeLayer> &addTreeVector, std::ofstream &assembly, uint limitLayer, bool verbose){
+void generate_add_reduction_assembly (const arch_config &arch, uint &curAddLayer, uint &curInstrCount, uint &numSw, uint originalSwPerWord, uint addTreeLayerTotal,
+                                    std::vector<addTreeLayer> &addTreeVector, std::ostream &assembly, uint limitLayer, bool verbose){
     for (;;) {
 
         // Check if more layers needs to be computed
@@ -234,8 +243,8 @@ void generate_add_reduction_assembly (uint &curAddLayer, uint &curInstrCount, ui
         }
 
         uint swProcessed = 0;   // Keep track of the number of subwords processed in the current layer not to do useless PACK operations
-        uint swInPerWord = WORD_BITS / swsize_to_uint(addTreeVector[curAddLayer].sw_in);
-        uint swOutPerWord = WORD_BITS / swsize_to_uint(addTreeVector[curAddLayer].sw_out);
+        uint swInPerWord = arch.word_bits / swsize_to_uint(addTreeVector[curAddLayer].sw_in);
+        uint swOutPerWord = arch.word_bits / swsize_to_uint(addTreeVector[curAddLayer].sw_out);
         uint originalWordPkt = lcm(swInPerWord, originalSwPerWord) / swInPerWord;   // How many words to hold the an entire original packet of subwords
         uint wordsPerLayer = div_ceil(numSw, swInPerWord);                         // How many words are needed to hold the entire layer of subwords
 
@@ -256,7 +265,7 @@ void generate_add_reduction_assembly (uint &curAddLayer, uint &curInstrCount, ui
         }
 
         // Check if the next layer can be added
-        if ((curInstrCount + VMVOpsPerReducLayer + ADDOpsPerReducLayer + SHIFTOpsPerReducLayer + PACKOpsPerReducLayer + 2 > IB_ENTRIES) ||
+        if ((curInstrCount + VMVOpsPerReducLayer + ADDOpsPerReducLayer + SHIFTOpsPerReducLayer + PACKOpsPerReducLayer + 2 > arch.ib_entries) ||
             (ADDOpsPerReducLayer == 0)) {
             if (verbose) {
                 std::cout << "Stopping reduction before layer " << addTreeVector[curAddLayer].idx << ", current instruction count is " << curInstrCount << std::endl;
@@ -358,8 +367,9 @@ void generate_add_reduction_assembly (uint &curAddLayer, uint &curInstrCount, ui
 
 /** 
  * Function to generate the assembly code for the GEMM operation.
+ * @param arch Architecture configuration
  * @param assembly Output stream for the assembly code
- * @param dataFile Output stream for the data file
+ * @param dataFile Output stream for the data file, no VWR data is generated if it is not good
  * @param addrFile Output stream for the address file
  * @param m Vertical dimension of the A matrix
  * @param n Horizontal dimension of the A matrix and vertical dimension of the B matrix
@@ -370,7 +380,7 @@ void generate_add_reduction_assembly (uint &curAddLayer, uint &curInstrCount, ui
  * @param verbose Flag to enable verbose output
  * @param gen Random number generator
  */
-void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &addrFile, 
+void map_gemm (const arch_config &arch, std::ostream &assembly, std::ostream &dataFile, std::ostream &addrFile, 
                 int m, int n, int q, int sw_bw, int csd_len, int dram_intvl, bool verbose, std::mt19937 &gen) {
 
     MAPMODE mapMode = MAPMODE::UNCONSTRAINED;   // Mapping mode, UNCONSTRAINED by default
@@ -381,7 +391,7 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
     uint64_t outputCol = 0;             // Assume output column 0
 
     // Compute the count of necessary operations
-    uint MULOpsPerBRow = div_ceil(q, (WORD_BITS * CORES_PER_PCH) / sw_bw);  // Number of VFUX MUL per row of B
+    uint MULOpsPerBRow = div_ceil(q, (arch.word_bits * arch.cores_per_pch) / sw_bw);  // Number of VFUX MUL per row of B
     uint addTreeInputsPerDP = n;                                            // Number of inputs to the add tree to compute dot product
     uint addTreeLayerTotal = uint(ceil(log2(addTreeInputsPerDP)));          // Number of layers in the add tree
 
@@ -392,7 +402,7 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
     }
 
     std::vector<addTreeLayer> addTreeVector;    // Vector to store the add tree layers
-    initiallizeAddTreeVector(addTreeVector, addTreeLayerTotal, addTreeInputsPerDP, sw_bw, q, verbose);   // Initialize the add tree vector
+    initiallizeAddTreeVector(arch, addTreeVector, addTreeLayerTotal, addTreeInputsPerDP, sw_bw, q, verbose);   // Initialize the add tree vector
 
     // Compute how many NOP cycles are needed after a VFUX MUL operation according to the CSD operand length and the DRAM standard
     uint maxCyclesPerMUL = (csd_len / 2) + 1 + 1;  // Worst case for multiplication is alternating 01010101... (csd_len/2+1), and writing to R0/1/2 (+1)
@@ -409,32 +419,32 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
     assembly << "; GEMM operation with dimensions " << m << "x" << n << " and " << n << "x" << q;
     assembly << ", with initial subword bitwidth = " << sw_bw << ", CSD length = " << csd_len;
     assembly << " and DRAM interval = " << dram_intvl << " cycles " << std::endl;
-    assembly << "; Hardware parameters: IB_ENTRIES = " << IB_ENTRIES << ", CSD_ENTRIES = " << CSD_ENTRIES << ", WORD_BITS = " << WORD_BITS;
-    assembly << ", VWR_BITS = " << VWR_BITS << ", CORES_PER_PCH = " << CORES_PER_PCH << std::endl << std::endl;
+    assembly << "; Hardware parameters: IB_ENTRIES = " << arch.ib_entries << ", CSD_ENTRIES = " << arch.csd_entries << ", WORD_BITS = " << arch.word_bits;
+    assembly << ", VWR_BITS = " << arch.vwr_bits << ", CORES_PER_PCH = " << arch.cores_per_pch << std::endl << std::endl;
     
     // Divide the matrix dimensions into tiles according to the hardware parameters
     // Initial check: can we multiply and do one complete addition layer given the IB / CSDRF sizes?
-    uint MULOpsPerMulChunk = std::min(2 * WORDS_PER_VWR, (n/2)*2);      // MULs needed per multiplication chunk (if odd, round down to even)
+    uint MULOpsPerMulChunk = std::min(2 * (int) arch.words_per_vwr(), (n/2)*2);      // MULs needed per multiplication chunk (if odd, round down to even)
     uint NOPOpsPerMulChunk = NOPCyclesPerMUL ? MULOpsPerMulChunk : 0;   // NOPs needed per multiplication chunk
     uint VMVOpsPerMulChunk = MULOpsPerMulChunk / 2;                     // VMVs needed per multiplication chunk
     uint ADDOpsPerMulChunk = MULOpsPerMulChunk / 2;                     // ADDs needed per multiplication chunk
     // PACK operations needed after first addition of the multiplication chunk
-    uint PACKOpsPerMulChunk = div_ceil (ADDOpsPerMulChunk * WORD_BITS / swsize_to_uint(addTreeVector[0].sw_in),
-                                            WORD_BITS / swsize_to_uint(addTreeVector[0].sw_out));
+    uint PACKOpsPerMulChunk = div_ceil (ADDOpsPerMulChunk * arch.word_bits / swsize_to_uint(addTreeVector[0].sw_in),
+                                            arch.word_bits / swsize_to_uint(addTreeVector[0].sw_out));
     PACKOpsPerMulChunk = (addTreeVector[0].sw_in == SWSIZE::B24) ? 0 : PACKOpsPerMulChunk; // No PACK operations if the initial subword size is 24 bits
     // Number of instructions per multiplication chunk
     uint instrPerMulChunk = 2 + MULOpsPerMulChunk + NOPOpsPerMulChunk +
                             VMVOpsPerMulChunk + ADDOpsPerMulChunk + PACKOpsPerMulChunk + 2;
 
     // Assess if we are limited by the CSDRF size. If so, update the parameters accordingly
-    if (MULOpsPerMulChunk > CSD_ENTRIES) {
+    if (MULOpsPerMulChunk > arch.csd_entries) {
         mapMode = MAPMODE::CSDRF_CONSTRAINED;
-        MULOpsPerMulChunk = CSD_ENTRIES;
-        NOPOpsPerMulChunk = NOPCyclesPerMUL ? CSD_ENTRIES : 0;
-        VMVOpsPerMulChunk = CSD_ENTRIES / 2;
-        ADDOpsPerMulChunk = CSD_ENTRIES / 2;
-        PACKOpsPerMulChunk = div_ceil (ADDOpsPerMulChunk * WORD_BITS / swsize_to_uint(addTreeVector[0].sw_in),
-                                            WORD_BITS / swsize_to_uint(addTreeVector[0].sw_out));
+        MULOpsPerMulChunk = arch.csd_entries;
+        NOPOpsPerMulChunk = NOPCyclesPerMUL ? arch.csd_entries : 0;
+        VMVOpsPerMulChunk = arch.csd_entries / 2;
+        ADDOpsPerMulChunk = arch.csd_entries / 2;
+        PACKOpsPerMulChunk = div_ceil (ADDOpsPerMulChunk * arch.word_bits / swsize_to_uint(addTreeVector[0].sw_in),
+                                            arch.word_bits / swsize_to_uint(addTreeVector[0].sw_out));
         PACKOpsPerMulChunk = (addTreeVector[0].sw_in == SWSIZE::B24) ? 0 : PACKOpsPerMulChunk; // No PACK operations if the initial subword size is 24 bits
         instrPerMulChunk = 2 + MULOpsPerMulChunk + NOPOpsPerMulChunk +
                             VMVOpsPerMulChunk + ADDOpsPerMulChunk + PACKOpsPerMulChunk + 2;
@@ -442,25 +452,25 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
 
     // Assess if we are limited by the IB size (more constraining than the CSDRF size)
     // If so, update the parameters accordingly
-    if (instrPerMulChunk > IB_ENTRIES) {
+    if (instrPerMulChunk > arch.ib_entries) {
         mapMode = MAPMODE::IB_CONSTRAINED;
         // Tile according to the IB size, making sure we can fit x MULs and the corresponding ADDs in the IB
-        MULOpsPerMulChunk = (IB_ENTRIES - 4) / 
-                                ((NOPCyclesPerMUL ? 3 : 2) + div_ceil(WORD_BITS / swsize_to_uint(addTreeVector[0].sw_in),
-                                                                        WORD_BITS / swsize_to_uint(addTreeVector[0].sw_out)));
+        MULOpsPerMulChunk = (arch.ib_entries - 4) / 
+                                ((NOPCyclesPerMUL ? 3 : 2) + div_ceil(arch.word_bits / swsize_to_uint(addTreeVector[0].sw_in),
+                                                                        arch.word_bits / swsize_to_uint(addTreeVector[0].sw_out)));
         MULOpsPerMulChunk = (MULOpsPerMulChunk / 2) * 2;    // Make sure it is even
         NOPOpsPerMulChunk = NOPCyclesPerMUL ? MULOpsPerMulChunk : 0;
         VMVOpsPerMulChunk = MULOpsPerMulChunk / 2;
         ADDOpsPerMulChunk = MULOpsPerMulChunk / 2;
-        PACKOpsPerMulChunk = div_ceil (ADDOpsPerMulChunk * WORD_BITS / swsize_to_uint(addTreeVector[0].sw_in),
-                                            WORD_BITS / swsize_to_uint(addTreeVector[0].sw_out));
+        PACKOpsPerMulChunk = div_ceil (ADDOpsPerMulChunk * arch.word_bits / swsize_to_uint(addTreeVector[0].sw_in),
+                                            arch.word_bits / swsize_to_uint(addTreeVector[0].sw_out));
         PACKOpsPerMulChunk = (addTreeVector[0].sw_in == SWSIZE::B24) ? 0 : PACKOpsPerMulChunk; // No PACK operations if the initial subword size is 24 bits
         instrPerMulChunk = 2 + MULOpsPerMulChunk + NOPOpsPerMulChunk +
                             VMVOpsPerMulChunk + ADDOpsPerMulChunk + PACKOpsPerMulChunk + 2;
     }
 
     if (verbose) {
-        std::cout << "IB size: " << IB_ENTRIES << ", CSDRF size: " << CSD_ENTRIES << std::endl;
+        std::cout << "IB size: " << arch.ib_entries << ", CSDRF size: " << arch.csd_entries << std::endl;
         std::cout << "Mapping mode: " << MAPMODE_STRING.at(mapMode) << std::endl;
         std::cout << "Number of MUL operations per multiplication chunk: " << MULOpsPerMulChunk << std::endl;
         std::cout << "Number of NOP operations per multiplication chunk: " << NOPOpsPerMulChunk << std::endl;
@@ -506,8 +516,8 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
     assembly << "WRF CSD_LEN " << csd_len << std::endl << std::endl;
 
     if (ext_loops) {
-        swInPerWord = WORD_BITS / swsize_to_uint(addTreeVector[0].sw_in);
-        swOutPerWord = WORD_BITS / swsize_to_uint(addTreeVector[0].sw_out);
+        swInPerWord = arch.word_bits / swsize_to_uint(addTreeVector[0].sw_in);
+        swOutPerWord = arch.word_bits / swsize_to_uint(addTreeVector[0].sw_out);
         wordPkt = lcm(swInPerWord, swOutPerWord) / swInPerWord;
         curWordPkt = 0;
         swInPerR2R1 = 2 * swInPerWord;
@@ -565,7 +575,7 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
         
         // If not constrained by the IB or the CSDRF sizes, continue the adder tree until possible
         if (mapMode == MAPMODE::UNCONSTRAINED) {    
-            generate_add_reduction_assembly(curAddLayer, curInstrCount, numSw, swInPerWord,
+            generate_add_reduction_assembly(arch, curAddLayer, curInstrCount, numSw, swInPerWord,
                                             addTreeLayerTotal, addTreeVector, assembly, 0, verbose);
             addLayerReached = curAddLayer;
         }
@@ -575,7 +585,7 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
         assembly << "WLB AddrFile VWR_0 ALL_WORDS" << std::endl;
         assembly << "WLB AddrFile VWR_1 ALL_WORDS" << std::endl;
         curInstrCount += 2;
-        if (curInstrCount < IB_ENTRIES) {
+        if (curInstrCount < arch.ib_entries) {
             assembly << "NOP 0" << std::endl;
         }
 
@@ -588,8 +598,8 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
             }
             assembly << "EXEC" << std::endl << std::endl;
             for (uint j = 0; j < loops; j++) {
-                write_random_vwr(swsize_to_uint(addTreeVector[0].sw_in), dataFile, gen);
-                write_random_vwr(swsize_to_uint(addTreeVector[0].sw_in), dataFile, gen);
+                write_random_vwr(arch, swsize_to_uint(addTreeVector[0].sw_in), dataFile, gen);
+                write_random_vwr(arch, swsize_to_uint(addTreeVector[0].sw_in), dataFile, gen);
                 addrFile << std::hex << std::showbase << nxt_addr(channel, inputRow, inputCol) << std::endl << nxt_addr(channel, inputRow, inputCol) << std::endl;
                 addrFile << std::hex << std::showbase << nxt_addr(channel, outputRow, outputCol) << std::endl << nxt_addr(channel, outputRow, outputCol) << std::endl;
             }
@@ -605,15 +615,15 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
         uint VMVOpsPeeling = ext_peeling / 2;                       // VMVs needed per peeling chunk
         uint ADDOpsPeeling = ext_peeling / 2;                       // ADDs needed per peeling chunk
         // PACK operations needed after first addition of the peeling chunk
-        uint PACKOpsPeeling = div_ceil ((ext_peeling / 2) * WORD_BITS / swsize_to_uint(addTreeVector[0].sw_in),
-                                                WORD_BITS / swsize_to_uint(addTreeVector[0].sw_out));
+        uint PACKOpsPeeling = div_ceil ((ext_peeling / 2) * arch.word_bits / swsize_to_uint(addTreeVector[0].sw_in),
+                                                arch.word_bits / swsize_to_uint(addTreeVector[0].sw_out));
         PACKOpsPeeling = (addTreeVector[0].sw_in == SWSIZE::B24) ? 0 : PACKOpsPeeling; // No PACK operations if the initial subword size is 24 bits
         // Number of instructions per peeling chunk
         uint instrPeeling = 2 + MULOpsPeeling + NOPOpsPeeling
                                 + VMVOpsPeeling + ADDOpsPeeling + PACKOpsPeeling + 2;
 
-        swInPerWord = WORD_BITS / swsize_to_uint(addTreeVector[0].sw_in);
-        swOutPerWord = WORD_BITS / swsize_to_uint(addTreeVector[0].sw_out);
+        swInPerWord = arch.word_bits / swsize_to_uint(addTreeVector[0].sw_in);
+        swOutPerWord = arch.word_bits / swsize_to_uint(addTreeVector[0].sw_out);
         wordPkt = lcm(swInPerWord, swOutPerWord) / swInPerWord;
         curWordPkt = 0;
         swInPerR2R1 = 2 * swInPerWord;
@@ -669,7 +679,7 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
         numSw = swInPerWord * ADDOpsPeeling;
 
         if (mapMode == MAPMODE::UNCONSTRAINED) {
-            generate_add_reduction_assembly(curAddLayer, curInstrCount, numSw, swInPerWord,
+            generate_add_reduction_assembly(arch, curAddLayer, curInstrCount, numSw, swInPerWord,
                                             addTreeLayerTotal, addTreeVector, assembly, addLayerReached, verbose);
         }
         inputNextLayer += numSw / swInPerWord;  // Track the output of the adder tree for the next layer
@@ -678,7 +688,7 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
         assembly << "WLB AddrFile VWR_0 ALL_WORDS" << std::endl;
         assembly << "WLB AddrFile VWR_1 ALL_WORDS" << std::endl;
         curInstrCount += 2;
-        if (curInstrCount < IB_ENTRIES) {
+        if (curInstrCount < arch.ib_entries) {
             assembly << "NOP 0" << std::endl;
         }
 
@@ -691,8 +701,8 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
             }
             assembly << "EXEC" << std::endl << std::endl;
             for (uint j = 0; j < loops; j++) {
-                write_random_vwr(swsize_to_uint(addTreeVector[0].sw_in), dataFile, gen);
-                write_random_vwr(swsize_to_uint(addTreeVector[0].sw_in), dataFile, gen);
+                write_random_vwr(arch, swsize_to_uint(addTreeVector[0].sw_in), dataFile, gen);
+                write_random_vwr(arch, swsize_to_uint(addTreeVector[0].sw_in), dataFile, gen);
                 addrFile << std::hex << std::showbase << nxt_addr(channel, inputRow, inputCol) << std::endl << nxt_addr(channel, inputRow, inputCol) << std::endl;
                 addrFile << std::hex << std::showbase << nxt_addr(channel, outputRow, outputCol) << std::endl << nxt_addr(channel, outputRow, outputCol) << std::endl;
             }
@@ -703,9 +713,9 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
     assembly << "; Multiplication complete, starting ADD reduction" << std::endl;
     while (addLayerReached < addTreeLayerTotal) {
 
-        swInPerWord = WORD_BITS / swsize_to_uint(addTreeVector[addLayerReached].sw_in);
+        swInPerWord = arch.word_bits / swsize_to_uint(addTreeVector[addLayerReached].sw_in);
 
-        loops = div_ceil(q, swInPerWord * CORES_PER_PCH); // Number of loops to cover q
+        loops = div_ceil(q, swInPerWord * arch.cores_per_pch); // Number of loops to cover q
 
         assembly << "WRF IB0" << std::endl;
         assembly << "RLB AddrFile VWR_0 ALL_WORDS DataFile" << std::endl;
@@ -714,11 +724,11 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
         curInstrCount = 2;
         curAddLayer = addLayerReached;
         if (addTreeVector[curAddLayer].sw_change != SWREPACK::INV) {
-            VMVOpsPerReducLayer = std::min(WORDS_PER_VWR,
-                                            (IB_ENTRIES - 4) / (int) (2 + div_ceil(WORD_BITS / swsize_to_uint(addTreeVector[curAddLayer].sw_in),
-                                                                                    WORD_BITS / swsize_to_uint(addTreeVector[curAddLayer].sw_out))));
+            VMVOpsPerReducLayer = std::min((int) arch.words_per_vwr(),
+                                            ((int) arch.ib_entries - 4) / (int) (2 + div_ceil(arch.word_bits / swsize_to_uint(addTreeVector[curAddLayer].sw_in),
+                                                                                    arch.word_bits / swsize_to_uint(addTreeVector[curAddLayer].sw_out))));
         } else {
-            VMVOpsPerReducLayer = std::min(WORDS_PER_VWR, (IB_ENTRIES - 4) / 2);
+            VMVOpsPerReducLayer = std::min((int) arch.words_per_vwr(), ((int) arch.ib_entries - 4) / 2);
         }
         VMVOpsPerReducLayer = std::min(VMVOpsPerReducLayer, inputNextLayer / 2);  // Limit to the number of additions
         VMVOpsPerReducLayer = std::max(VMVOpsPerReducLayer, 1U); // At least one addition
@@ -728,14 +738,14 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
         uint loopsReducLayer = div_ceil(inputNextLayer, 2 * VMVOpsPerReducLayer);
 
         // Generate assembly code for the next layer
-        generate_add_reduction_assembly(curAddLayer, curInstrCount, numSw, swInPerWord,
+        generate_add_reduction_assembly(arch, curAddLayer, curInstrCount, numSw, swInPerWord,
                                         addTreeLayerTotal, addTreeVector, assembly, 0, verbose);
         inputNextLayer = (numSw / swInPerWord) * loopsReducLayer;   // Track the output of the adder tree for the next layer
 
         assembly << "WLB AddrFile VWR_0 ALL_WORDS" << std::endl;
         assembly << "WLB AddrFile VWR_1 ALL_WORDS" << std::endl;
         curInstrCount += 2;
-        if (curInstrCount < IB_ENTRIES) {
+        if (curInstrCount < arch.ib_entries) {
             assembly << "NOP 0" << std::endl;
         }
 
@@ -744,8 +754,8 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
         for (uint i = 0; i < m*loopsReducLayer; i++) {
             assembly << "EXEC" << std::endl;
             for (uint j = 0; j < loops; j++) {
-                write_random_vwr(swsize_to_uint(addTreeVector[addLayerReached].sw_in), dataFile, gen);
-                write_random_vwr(swsize_to_uint(addTreeVector[addLayerReached].sw_in), dataFile, gen);
+                write_random_vwr(arch, swsize_to_uint(addTreeVector[addLayerReached].sw_in), dataFile, gen);
+                write_random_vwr(arch, swsize_to_uint(addTreeVector[addLayerReached].sw_in), dataFile, gen);
                 addrFile << std::hex << std::showbase << nxt_addr(channel, outputRow, outputCol) << std::endl << nxt_addr(channel, outputCol, outputCol) << std::endl;
                 addrFile << std::hex << std::showbase << nxt_addr(channel, outputRow, outputCol) << std::endl << nxt_addr(channel, outputRow, outputCol) << std::endl;
             }
@@ -757,8 +767,8 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
     // Predicted adder tree layers are completed, but they are not enough to cover the entire output
     if (inputNextLayer > 1) {
         assembly << "; Final ADD reduction, exceeding predicted number of tree layers" << std::endl;
-        swInPerWord = WORD_BITS / swsize_to_uint(addTreeVector[addLayerReached-1].sw_out);
-        loops = div_ceil(q, swInPerWord * CORES_PER_PCH); // Number of loops to cover q
+        swInPerWord = arch.word_bits / swsize_to_uint(addTreeVector[addLayerReached-1].sw_out);
+        loops = div_ceil(q, swInPerWord * arch.cores_per_pch); // Number of loops to cover q
 
         assembly << "WRF IB0" << std::endl;
         assembly << "RLB AddrFile VWR_0 ALL_WORDS DataFile" << std::endl;
@@ -790,7 +800,7 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
 
         assembly << "WLB AddrFile VWR_0 ALL_WORDS" << std::endl;
         curInstrCount += 1;
-        if (curInstrCount < IB_ENTRIES) {
+        if (curInstrCount < arch.ib_entries) {
             assembly << "NOP 0" << std::endl;
         }
 
@@ -799,8 +809,8 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
         for (uint i = 0; i < m; i++) {
             assembly << "EXEC" << std::endl;
             for (uint j = 0; j < loops; j++) {
-                write_random_vwr(swsize_to_uint(addTreeVector[addLayerReached-1].sw_out), dataFile, gen);
-                write_random_vwr(swsize_to_uint(addTreeVector[addLayerReached-1].sw_out), dataFile, gen);
+                write_random_vwr(arch, swsize_to_uint(addTreeVector[addLayerReached-1].sw_out), dataFile, gen);
+                write_random_vwr(arch, swsize_to_uint(addTreeVector[addLayerReached-1].sw_out), dataFile, gen);
                 addrFile << std::hex << std::showbase << nxt_addr(channel, outputRow, outputCol) << std::endl << nxt_addr(channel, outputCol, outputCol) << std::endl;
                 addrFile << std::hex << std::showbase << nxt_addr(channel, outputRow, outputCol) << std::endl;
             }
@@ -810,11 +820,16 @@ void map_gemm (std::ofstream &assembly, std::ofstream &dataFile, std::ofstream &
     return;
 }
 
+#ifndef GEN_GEMM_ASSEMBLY_LIB  // Built as part of a tool that maps GEMMs in-process
 int main (int argc, char **argv) {
     // Parse the command line arguments
     int m, n, q, sw_bw, csd_len, dram_intvl;
     std::string output;
     bool verbose = false;
+    arch_config arch;   // Hardware parameters, defs.h unless overridden with --config=<file> or --<PARAM>=<value>
+    if (!arch.parse_args(argc, argv)) {
+        exit(1);
+    }
     parse_args(argc, argv, m, n, q, sw_bw, csd_len, dram_intvl, output, verbose);
 
     // Open the output files
@@ -830,7 +845,7 @@ int main (int argc, char **argv) {
     std::cout << ", and minimum interval between consecutive DRAM commands at the column of " << dram_intvl << std::endl;
 
     // Generate the assembly code
-    map_gemm(assembly, dataFile, addrFile, m, n, q, sw_bw, csd_len, dram_intvl, verbose, gen);
+    map_gemm(arch, assembly, dataFile, addrFile, m, n, q, sw_bw, csd_len, dram_intvl, verbose, gen);
 
     // Close the output files
     assembly.close();
@@ -838,4 +853,5 @@ int main (int argc, char **argv) {
     addrFile.close();
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -2,6 +2,7 @@
 #define __GEN_GEMM_ASSEMBLY_H__
 
 #include <map>
+#include <vector>
 #include <stdlib.h>
 #include <string>
 #include <iostream>
@@ -11,6 +12,7 @@
 #include <math.h>
 
 #include "../../src/defs.h"
+#include "../../src/arch_config.h"
 #include "../../src/opcodes.h"
 #include "../../src/microcode/common_format.h"
 #if (INSTR_FORMAT == BASE_FORMAT)
@@ -0,0 +1,686 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Golden reference of the SoftSIMD programs of gen_gemm_assembly. Runs the
+ * assembly at instruction level on the operands of its data file, with the
+ * subwords of each word as fixed-point lanes: additions wrap within the
+ * subword, right shifts keep its sign, repacking to wider subwords keeps the
+ * value and to narrower ones its MSBs, and multiplications follow the
+ * shift-and-add recoding of the CSD multiplier done by the multiplication
+ * sequencer. The words of every WLB are compared with the PIM WRs of a
+ * .results file, in order.
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../src/defs.h"
+#include "../../src/arch_config.h"
+#include "../../src/opcodes.h"
+#include "../../src/packed_bits.h"
+
+using namespace std;
+
+// Format of assembly input:    Inst        [Operands]
+// Format of results:           Cycle       Address     Data
+
+// Storage of an operand, R0 is written by VMV and is the first operand of the VFUX
+enum class LOC : uint {R0, R1, R2, R3, VWR};
+
+enum class OP : uint {NOP, EXIT, RLB, WLB, VMV, RMV, ADD, SUB, SHIFT, MUL, PACK};
+
+typedef struct ref_instr {
+    OP op;
+    uint size;              // Subword bits of the VFUX, input ones of the PACK
+    uint outSize;           // Output subword bits of the PACK
+    uint shift;             // VFUX SHIFT amount
+    uint start;             // First subword of the PACK
+    uint csd;               // CSD register of the MUL
+    LOC src, dst;
+    uint srcVwr, srcIdx;    // VWR and word, if the source is a VWR
+    uint dstVwr, dstIdx;    // VWR and word, if the destination is a VWR
+    bool dataFile;          // RLB data from the data file, otherwise in data
+    vector<uint64_t> data;
+} ref_instr;
+
+// Step of a multiplication: the accumulator shifted right, then x added or subtracted
+enum class MUL_OP : uint {SET, NEG, ZERO, NOP, ADD, SUB};
+typedef struct mul_step {
+    MUL_OP op;
+    uint shift;
+} mul_step;
+
+// PIM WR expected from a WLB
+typedef struct ref_write {
+    uint64_t addr;
+    vector<uint64_t> data;  // VWR_64B words per core
+} ref_write;
+
+class golden_ref {
+public:
+    vector<ref_write> writes;
+
+    golden_ref(const arch_config &arch_) : arch(arch_), ib(arch_.ib_entries), csdrf(arch_.csd_entries, 0),
+            vwr(arch_.cores_per_pch * arch_.vwr_num, vector<uint64_t>(arch_.vwr_64b() + 1, 0)),
+            R(arch_.cores_per_pch * 4, vector<uint64_t>(arch_.word_64b() + 1, 0)) {
+        csdLen = arch.csd_bits / 2;
+        lanesA.resize(arch.word_bits);
+        lanesB.resize(arch.word_bits);
+        word.resize(arch.word_64b() + 1);
+    }
+
+    bool run(istream &assembly, istream &dataFile, istream &addrFile);
+
+private:
+    const arch_config &arch;
+    vector<ref_instr> ib;
+    vector<uint64_t> csdrf;
+    uint csdLen;
+    uint loopStart = 0, loopEnd = 0, loopNumIter = 0;
+    vector<vector<uint64_t> > vwr;      // By core and VWR, with a spare word for packed_get
+    vector<vector<uint64_t> > R;        // By core and register
+    vector<int64_t> lanesA, lanesB;     // Subwords of the operands, sign extended
+    vector<uint64_t> word;
+    uint currLine = 0;
+
+    bool parse_instr(istringstream &is, const string &instr, ref_instr &ri);
+    bool exec(istream &dataFile, istream &addrFile);
+    void execute(const ref_instr &ri, uint core);
+
+    uint64_t *reg(uint core, LOC loc) {
+        return R[core*4 + uint(loc)].data();
+    }
+    uint64_t *vwr_of(uint core, uint n) {
+        return vwr[core*arch.vwr_num + n].data();
+    }
+    void read_word(uint core, LOC loc, uint n, uint idx, uint64_t *out);
+    void write_word(uint core, LOC loc, uint n, uint idx, const uint64_t *in);
+    void csd_steps(uint64_t csd, vector<mul_step> &steps) const;
+};
+
+// Sign extension of the size LSBs of a value
+static inline int64_t sign_extend(uint64_t v, uint size) {
+    return (int64_t) (v << (64 - size)) >> (64 - size);
+}
+
+static void unpack_lanes(const uint64_t *w, uint size, uint n, int64_t *lanes) {
+    for (uint i = 0; i < n; i++) {
+        lanes[i] = sign_extend(packed_get(w, i*size, size), size);
+    }
+}
+
+// The lanes are wrapped to their size when packed
+static void pack_lanes(const int64_t *lanes, uint size, uint n, uint64_t *w, uint wordBits) {
+    memset(w, 0, PACKED_64B(wordBits) * sizeof(uint64_t));
+    for (uint i = 0; i < n; i++) {
+        packed_set(w, i*size, size, (uint64_t) lanes[i]);
+    }
+}
+
+// Number after a prefix (LEN_4, CSD3, VWR_1), false if there is none
+static bool suffix_number(const string &s, const string &prefix, uint &n) {
+    if (s.compare(0, prefix.size(), prefix) || s.size() == prefix.size()) {
+        return false;
+    }
+    n = stoul(s.substr(prefix.size()));
+    return true;
+}
+
+// VWR_<n>[<idx>], or VWR_<n> if a whole VWR is allowed
+static bool parse_vwr(const string &s, uint &n, uint &idx, bool word) {
+    size_t open = s.find('[');
+    idx = 0;
+    if (!suffix_number(s.substr(0, open), "VWR_", n)) {
+        return false;
+    }
+    if (open == string::npos) {
+        return !word;
+    }
+    idx = stoul(s.substr(open + 1));
+    return true;
+}
+
+// Next line of a data or address file that is not empty nor a comment
+static bool next_line(istream &is, string &line) {
+    do {
+        if (!getline(is, line)) {
+            return false;
+        }
+    } while (line.empty() || line[0] == '#');
+    return true;
+}
+
+void golden_ref::read_word(uint core, LOC loc, uint n, uint idx, uint64_t *out) {
+    if (loc == LOC::VWR) {
+        memset(out, 0, (arch.word_64b() + 1) * sizeof(uint64_t));
+        packed_copy(out, 0, vwr_of(core, n), idx*arch.word_bits, arch.word_bits);
+    } else {
+        memcpy(out, reg(core, loc), (arch.word_64b() + 1) * sizeof(uint64_t));
+    }
+}
+
+void golden_ref::write_word(uint core, LOC loc, uint n, uint idx, const uint64_t *in) {
+    if (loc == LOC::VWR) {
+        packed_copy(vwr_of(core, n), idx*arch.word_bits, in, 0, arch.word_bits);
+    } else {
+        memcpy(reg(core, loc), in, (arch.word_64b() + 1) * sizeof(uint64_t));
+    }
+}
+
+// Steps of the multiplication sequencer for a CSD multiplier. It looks for the
+// non-zero digits from the LSB in windows of SA_MAX_SHIFT digits: the first one
+// sets the accumulator, and each one after it is added after shifting by its
+// distance. A window without non-zero digits shifts at most 3 bits
+void golden_ref::csd_steps(uint64_t csd, vector<mul_step> &steps) const {
+    uint idx = 0, next, k, digit;
+    uint window = 2*arch.sa_max_shift;    // Bits of a window, 2 per digit
+    bool first = true, found;
+
+    auto window_at = [&](uint i) -> uint64_t {
+        if (i % 2 || i > arch.csd_bits) {
+            i = 0;
+        }
+        return (i < 64 ? csd >> i : 0) & packed_lsb_mask(window);
+    };
+
+    steps.clear();
+
+    // First non-zero digit. The first window is always followed by more steps,
+    // the next ones end the multiplication when reaching the length
+    for (;;) {
+        uint64_t w = window_at(idx);
+        next = idx + window;
+        found = false;
+        for (k = 0; k < window; k += 2) {
+            digit = (w >> k) & 3;
+            if (digit != CSD_ZERO) {
+                steps.push_back({(digit == CSD_POSONE) ? MUL_OP::SET : MUL_OP::NEG, 0});
+                next = idx + k + 2;
+                found = true;
+                break;
+            }
+        }
+        if (found && (first || next < 2*csdLen)) {
+            idx = next;
+            break;
+        } else if (found || (!first && next >= 2*csdLen)) {
+            if (!found) {
+                steps.push_back({MUL_OP::ZERO, 0});
+            }
+            return;
+        }
+        idx = next;
+        first = false;
+    }
+
+    // Shifts and additions of the following digits, up to the length
+    do {
+        uint64_t w = window_at(idx);
+        uint left = csdLen - idx/2;
+        mul_step step = {MUL_OP::NOP, (left < 3) ? left : 3};
+        next = idx + window;
+        for (k = 0; k < window; k += 2) {
+            digit = (w >> k) & 3;
+            if (digit != CSD_ZERO) {
+                step = {(digit == CSD_POSONE) ? MUL_OP::ADD : MUL_OP::SUB, k/2 + 1};
+                next = idx + k + 2;
+                break;
+            }
+        }
+        steps.push_back(step);
+        idx = next;
+    } while (idx < 2*csdLen);
+}
+
+void golden_ref::execute(const ref_instr &ri, uint core) {
+    uint n = (ri.op == OP::PACK || !ri.size) ? 0 : arch.word_bits / ri.size;
+    uint64_t *w = word.data();
+    int64_t *a = lanesA.data(), *b = lanesB.data();
+    uint i;
+
+    switch (ri.op) {
+        case OP::VMV:
+            read_word(core, LOC::VWR, ri.srcVwr, ri.srcIdx, w);
+            write_word(core, LOC::R0, 0, 0, w);
+        break;
+        case OP::RMV:
+            read_word(core, LOC::R3, 0, 0, w);
+            write_word(core, LOC::VWR, ri.dstVwr, ri.dstIdx, w);
+        break;
+
+        case OP::ADD:
+        case OP::SUB:
+        case OP::SHIFT:
+            read_word(core, ri.src, ri.srcVwr, ri.srcIdx, w);
+            unpack_lanes(w, ri.size, n, b);
+            if (ri.op == OP::SHIFT) {
+                // Right shift keeping the sign, bypassed if above SA_MAX_SHIFT
+                uint shift = (ri.shift > arch.sa_max_shift) ? 0 : ri.shift;
+                for (i = 0; i < n; i++) {
+                    a[i] = b[i] >> shift;
+                }
+            } else {
+                unpack_lanes(reg(core, LOC::R0), ri.size, n, a);
+                if (ri.op == OP::ADD) {
+                    for (i = 0; i < n; i++) {
+                        a[i] += b[i];
+                    }
+                } else {
+                    for (i = 0; i < n; i++) {
+                        a[i] -= b[i];
+                    }
+                }
+            }
+            pack_lanes(a, ri.size, n, w, arch.word_bits);
+            write_word(core, ri.dst, ri.dstVwr, ri.dstIdx, w);
+        break;
+
+        case OP::MUL: {
+            vector<mul_step> steps;
+            csd_steps(csdrf[ri.csd], steps);
+            read_word(core, ri.src, ri.srcVwr, ri.srcIdx, w);
+            unpack_lanes(w, ri.size, n, b);
+            for (const mul_step &s : steps) {
+                uint shift = (s.shift > arch.sa_max_shift) ? 0 : s.shift;
+                switch (s.op) {
+                    case MUL_OP::SET:   for (i = 0; i < n; i++) a[i] = b[i];                        break;
+                    case MUL_OP::NEG:   for (i = 0; i < n; i++) a[i] = -b[i];                       break;
+                    case MUL_OP::ZERO:  for (i = 0; i < n; i++) a[i] = 0;                           break;
+                    case MUL_OP::NOP:   for (i = 0; i < n; i++) a[i] = a[i] >> shift;               break;
+                    case MUL_OP::ADD:   for (i = 0; i < n; i++) a[i] = (a[i] >> shift) + b[i];      break;
+                    case MUL_OP::SUB:   for (i = 0; i < n; i++) a[i] = (a[i] >> shift) - b[i];      break;
+                }
+                // Wrap to the subword after each step, as the datapath does
+                for (i = 0; i < n; i++) {
+                    a[i] = sign_extend((uint64_t) a[i], ri.size);
+                }
+            }
+            pack_lanes(a, ri.size, n, w, arch.word_bits);
+            write_word(core, LOC::R3, 0, 0, w);     // The accumulator
+            if (ri.dst != LOC::R3) {
+                write_word(core, ri.dst, ri.dstVwr, ri.dstIdx, w);
+            }
+        } break;
+
+        case OP::PACK: {
+            // Subwords of R1 then R2 from start, to fill a word of the output size
+            // (within each MASK_BITS chunk with LOCAL_REPACK), MSB aligned. Not legal
+            // sizes or start copy R1. The output is then shifted right to sign extend
+            // the subwords that grew, also when R1 is copied
+            const uint64_t *w1 = reg(core, LOC::R1), *w2 = reg(core, LOC::R2);
+            uint chunkBits = LOCAL_REPACK ? arch.mask_bits : arch.word_bits;
+            uint shift = (ri.outSize > ri.size) ? ri.outSize - ri.size : 0;
+            if (ri.size > arch.mask_bits || ri.outSize > arch.mask_bits || !ri.size || !ri.outSize
+                    || ri.start >= 2*(arch.mask_bits/ri.size)) {
+                read_word(core, LOC::R1, 0, 0, w);
+            } else {
+                uint inPerChunk = chunkBits / ri.size;
+                memset(w, 0, (arch.word_64b() + 1) * sizeof(uint64_t));
+                for (uint c = 0; c < arch.word_bits / chunkBits; c++) {
+                    for (uint j = 0; j < chunkBits / ri.outSize; j++) {
+                        uint inIdx = (j + ri.start) % (2*inPerChunk);
+                        const uint64_t *src = (inIdx >= inPerChunk) ? w2 : w1;
+                        uint64_t v = packed_get(src, c*chunkBits + (inIdx % inPerChunk)*ri.size, ri.size);
+                        v = (ri.size < ri.outSize) ? v << shift : v >> (ri.size - ri.outSize);
+                        packed_set(w, c*chunkBits + j*ri.outSize, ri.outSize, v);
+                    }
+                }
+            }
+            if (shift && shift <= arch.pm_max_shift && ri.outSize) {
+                n = arch.word_bits / ri.outSize;
+                unpack_lanes(w, ri.outSize, n, a);
+                for (i = 0; i < n; i++) {
+                    a[i] >>= shift;
+                }
+                pack_lanes(a, ri.outSize, n, w, arch.word_bits);
+            }
+            write_word(core, ri.dst, ri.dstVwr, ri.dstIdx, w);
+        } break;
+
+        default:
+        break;
+    }
+}
+
+bool golden_ref::parse_instr(istringstream &is, const string &instr, ref_instr &ri) {
+    string a, b, c, d;
+
+    ri = {OP::NOP, 0, 0, 0, 0, 0, LOC::R0, LOC::R0, 0, 0, 0, 0, false, {}};
+    if (instr == "NOP") {
+        uint imm;
+        if (!(is >> imm)) {
+            return false;
+        }
+        ri.op = imm ? OP::NOP : OP::EXIT;
+
+    } else if (instr == "RLB" || instr == "WLB") {
+        // Only whole VWRs, with the address from the address file
+        if (!(is >> a >> b >> c) || a != "AddrFile" || c != "ALL_WORDS" || !parse_vwr(b, ri.dstVwr, ri.dstIdx, false)) {
+            return false;
+        }
+        ri.op = (instr == "RLB") ? OP::RLB : OP::WLB;
+        ri.srcVwr = ri.dstVwr;
+        if (ri.op == OP::RLB && is >> d) {
+            if (d == "DataFile") {
+                ri.dataFile = true;
+            } else {
+                ri.data.push_back(stoull(d, 0, 0));
+                uint64_t dataAux;
+                while (is >> hex >> dataAux) {
+                    ri.data.push_back(dataAux);
+                }
+            }
+        }
+
+    } else if (instr == "VMV" || instr == "RMV") {
+        if (!(is >> a) || !parse_vwr(a, ri.srcVwr, ri.srcIdx, true)) {
+            return false;
+        }
+        ri.op = (instr == "VMV") ? OP::VMV : OP::RMV;
+        ri.dstVwr = ri.srcVwr;
+        ri.dstIdx = ri.srcIdx;
+
+    } else if (instr == "VFUX") {
+        if (!(is >> a)) {
+            return false;
+        }
+        if (a == "SHIFT" && !(is >> ri.shift)) {
+            return false;
+        }
+        if (!(is >> b >> c >> d) || !suffix_number(b, "LEN_", ri.size)) {
+            return false;
+        }
+        if (a == "MUL") {
+            ri.op = OP::MUL;
+            if (!suffix_number(c, "CSD", ri.csd) || ri.csd >= arch.csd_entries || !(is >> b) || !parse_vwr(b, ri.srcVwr, ri.srcIdx, true)) {
+                return false;
+            }
+            ri.src = LOC::VWR;
+        } else {
+            ri.op = (a == "ADD") ? OP::ADD : (a == "SUB") ? OP::SUB : OP::SHIFT;
+            if (a != "ADD" && a != "SUB" && a != "SHIFT") {
+                return false;
+            }
+            if (c == "SRC_VWR") {
+                if (!(is >> b) || !parse_vwr(b, ri.srcVwr, ri.srcIdx, true)) {
+                    return false;
+                }
+                ri.src = LOC::VWR;
+            } else {
+                ri.src = LOC::R3;
+            }
+        }
+        if (d == "OUT_VWR") {
+            if (!(is >> b) || !parse_vwr(b, ri.dstVwr, ri.dstIdx, true)) {
+                return false;
+            }
+            ri.dst = LOC::VWR;
+        } else if (d == "OUT_R1" || d == "OUT_R2" || d == "OUT_R3") {
+            ri.dst = LOC(uint(LOC::R1) + d[5] - '1');
+        } else {
+            return false;
+        }
+        if (!ri.size || ri.size > 64) {
+            return false;
+        }
+
+    } else if (instr == "PACK") {
+        size_t sep;
+        if (!(is >> a >> ri.start >> b) || a.compare(0, 7, "CHANGE_") || (sep = a.find('_', 7)) == string::npos) {
+            return false;
+        }
+        ri.op = OP::PACK;
+        ri.size = stoul(a.substr(7, sep - 7));
+        ri.outSize = stoul(a.substr(sep + 1));
+        if (b == "OUT_VWR") {
+            if (!(is >> c) || !parse_vwr(c, ri.dstVwr, ri.dstIdx, true)) {
+                return false;
+            }
+            ri.dst = LOC::VWR;
+        } else if (b == "OUT_R3") {
+            ri.dst = LOC::R3;
+        } else {
+            return false;
+        }
+        if (ri.size > 64 || ri.outSize > 64) {
+            return false;
+        }
+
+    } else {
+        return false;
+    }
+
+    // Operands out of the VWRs
+    if ((ri.src == LOC::VWR || ri.op == OP::VMV) && (ri.srcVwr >= arch.vwr_num || ri.srcIdx >= arch.words_per_vwr())) {
+        return false;
+    }
+    if ((ri.dst == LOC::VWR || ri.op == OP::RLB || ri.op == OP::WLB) && (ri.dstVwr >= arch.vwr_num || ri.dstIdx >= arch.words_per_vwr())) {
+        return false;
+    }
+    return true;
+}
+
+// Runs the program in the IB, from the first entry until NOP 0 or the end of the IB
+bool golden_ref::exec(istream &dataFile, istream &addrFile) {
+    uint execIdx = 0, loopCurrIter = 0, core;
+    string line;
+
+    for (;;) {
+        const ref_instr &ri = ib[execIdx];
+
+        if (ri.op == OP::RLB || ri.op == OP::WLB) {
+            uint64_t addr;
+            if (!next_line(addrFile, line) || !(istringstream(line) >> hex >> addr)) {
+                cout << "Error, address file cannot be read" << endl;
+                return false;
+            }
+            if (ri.op == OP::RLB) {
+                vector<uint64_t> data = ri.data;
+                if (ri.dataFile) {
+                    uint64_t dataAux;
+                    if (!next_line(dataFile, line)) {
+                        cout << "Error, data file cannot be read" << endl;
+                        return false;
+                    }
+                    istringstream ls(line);
+                    while (ls >> hex >> dataAux) {
+                        data.push_back(dataAux);
+                    }
+                }
+                // Without data the banks are not driven, and the VWRs keep the bus value of zero
+                data.resize(arch.cores_per_pch * arch.vwr_64b(), 0);
+                for (core = 0; core < arch.cores_per_pch; core++) {
+                    uint64_t *v = vwr_of(core, ri.dstVwr);
+                    memcpy(v, &data[core * arch.vwr_64b()], arch.vwr_64b() * sizeof(uint64_t));
+                    packed_clear(v, arch.words_per_vwr() * arch.word_bits, arch.vwr_64b() * 64);
+                }
+            } else {
+                ref_write wr = {addr, vector<uint64_t>(arch.cores_per_pch * arch.vwr_64b())};
+                for (core = 0; core < arch.cores_per_pch; core++) {
+                    memcpy(&wr.data[core * arch.vwr_64b()], vwr_of(core, ri.srcVwr), arch.vwr_64b() * sizeof(uint64_t));
+                }
+                writes.push_back(move(wr));
+            }
+        } else {
+            for (core = 0; core < arch.cores_per_pch; core++) {
+                execute(ri, core);
+            }
+        }
+
+        if (ri.op == OP::EXIT) {
+            break;
+        } else if (loopNumIter && execIdx == loopEnd && loopCurrIter < loopNumIter - 1) {
+            loopCurrIter++;
+            execIdx = loopStart;
+        } else if (++execIdx >= arch.ib_entries) {
+            break;
+        }
+    }
+    return true;
+}
+
+bool golden_ref::run(istream &assembly, istream &dataFile, istream &addrFile) {
+    uint ibIdx = 0;
+    bool ibWrMode = false;
+    string line, instr, store, dataString;
+
+    while (getline(assembly, line)) {
+        istringstream is(line);
+        currLine++;
+        if (line.empty() || line[0] == ';' || !(is >> instr)) {
+            continue;
+        }
+
+        if (instr == "WRF") {
+            is >> store;
+            uint idx = 0;
+            size_t digits = store.find_first_of("0123456789");
+            if (digits != string::npos) {
+                idx = stoul(store.substr(digits));
+                store = store.substr(0, digits);
+            }
+            if (store == "IB") {
+                ibWrMode = true;
+                ibIdx = idx;
+                continue;
+            }
+            ibWrMode = false;
+
+            // Value of the RF, from the data file or the assembly
+            uint64_t value = 0;
+            if (is >> dataString) {
+                if (dataString == "DataFile") {
+                    if (!next_line(dataFile, line) || !(istringstream(line) >> hex >> value)) {
+                        cout << "Error, data file cannot be read at line " << currLine << endl;
+                        return false;
+                    }
+                } else {
+                    value = stoull(dataString, 0, 0);
+                }
+            }
+            if (store == "CSD" && idx < arch.csd_entries) {
+                csdrf[idx] = value;
+            } else if (store == "CSD_LEN") {
+                csdLen = value;
+            } else if (store != "SRF" && store != "MRF") {      // Scalars and masks are not used by the supported instructions
+                cout << "Error, unsupported RF " << store << " at line " << currLine << endl;
+                return false;
+            }
+
+        } else if (instr == "LOOP") {
+            if (!(is >> loopStart >> loopEnd >> loopNumIter)) {
+                cout << "Error when programming the hardware loop at line " << currLine << endl;
+                return false;
+            }
+
+        } else if (instr == "EXEC") {
+            ibWrMode = false;
+            if (!exec(dataFile, addrFile)) {
+                return false;
+            }
+
+        } else if (ibWrMode && ibIdx < arch.ib_entries) {
+            if (!parse_instr(is, instr, ib[ibIdx])) {
+                cout << "Error, instruction not supported by the reference at line " << currLine << ": " << line << endl;
+                return false;
+            }
+            ibIdx++;
+
+        } else {
+            cout << "Error, unexpected instruction at line " << currLine << ": " << line << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, const char *argv[])
+{
+    // Hardware parameters, defs.h unless overridden with --config=<file> or --<PARAM>=<value>
+    arch_config arch;
+    if (!arch.parse_args(argc, argv)) {
+        return 1;
+    }
+    uint maxReport = 8;
+    int i, kept = 1;
+    for (i = 1; i < argc; i++) {
+        if (!strncmp(argv[i], "--report=", 9)) {
+            maxReport = atoi(argv[i] + 9);
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
+    if (argc != 5) {
+        cout << "Usage: " << argv[0] << " <assembly-input> <data-input> <address-input> <results-file> [--report=<N>] [--config=<file>] [--<PARAM>=<value>]" << endl;
+        return 2;
+    }
+
+    ifstream assembly(argv[1]), dataFile(argv[2]), addrFile(argv[3]), results(argv[4]);
+    if (!assembly.is_open() || !dataFile.is_open() || !addrFile.is_open() || !results.is_open()) {
+        cout << "Error when opening the input files" << endl;
+        return 2;
+    }
+
+    golden_ref ref(arch);
+    if (!ref.run(assembly, dataFile, addrFile)) {
+        return 2;
+    }
+
+    // Word by word comparison with the PIM WRs of the simulation
+    string line, cycle;
+    uint64_t addr, dataAux, badWords = 0, badWrites = 0, numResults = 0;
+    vector<uint64_t> data;
+    for (const ref_write &wr : ref.writes) {
+        if (!getline(results, line)) {
+            break;
+        }
+        istringstream is(line);
+        data.clear();
+        is >> cycle >> hex >> addr;
+        while (is >> hex >> dataAux) {
+            data.push_back(dataAux);
+        }
+        numResults++;
+
+        uint64_t bad = (addr != wr.addr);
+        if (bad && badWrites < maxReport) {
+            cout << "Write " << dec << numResults << " (cycle " << cycle << "): address " << showbase << hex << addr << ", expected " << wr.addr << endl;
+        }
+        for (size_t w = 0; w < wr.data.size(); w++) {
+            uint64_t got = (w < data.size()) ? data[w] : 0;
+            if (got != wr.data[w] || w >= data.size()) {
+                if (badWords < maxReport) {
+                    cout << "Write " << dec << numResults << " (cycle " << cycle << "), core " << w / arch.vwr_64b() << ", 64-bit word " << w % arch.vwr_64b()
+                            << ": " << showbase << hex << got << ", expected " << wr.data[w] << endl;
+                }
+                badWords++;
+                bad = true;
+            }
+        }
+        badWrites += bad;
+    }
+    while (getline(results, line)) {
+        numResults++;
+    }
+
+    cout << dec << ref.writes.size() << " writes expected, " << numResults << " simulated, " << badWrites << " mismatching ("
+            << badWords << " 64-bit words)" << endl;
+    if (numResults != ref.writes.size() || badWrites) {
+        cout << "Golden check FAILED" << endl;
+        return 1;
+    }
+    cout << "Golden check passed" << endl;
+    return 0;
+}
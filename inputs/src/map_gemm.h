@@ -0,0 +1,15 @@
+#ifndef MAP_GEMM_H_
+#define MAP_GEMM_H_
+
+#include <ostream>
+#include <random>
+
+#include "../../src/arch_config.h"
+
+// Maps a GEMM (m x n by n x q) on an architecture, writing the assembly program
+// and the data and address files it reads. The VWR data is not generated when
+// dataFile is not good, which is all the cycle model needs
+void map_gemm (const arch_config &arch, std::ostream &assembly, std::ostream &dataFile, std::ostream &addrFile,
+                int m, int n, int q, int sw_bw, int csd_len, int dram_intvl, bool verbose, std::mt19937 &gen);
+
+#endif /* MAP_GEMM_H_ */
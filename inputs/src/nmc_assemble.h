@@ -0,0 +1,17 @@
+#ifndef NMC_ASSEMBLE_H_
+#define NMC_ASSEMBLE_H_
+
+#include <functional>
+#include <istream>
+
+#include "../../src/trace_cmd.h"
+
+// Receives the commands of the raw sequence as they are assembled
+typedef std::function<void(const trace_cmd &)> raw_sink;
+
+// Assembles an NMC program into the commands of the raw sequence. The data and
+// address files are only read by instructions that refer to them.
+// Returns false on error
+bool nmc_assemble(std::istream &assembly, std::istream &dataFile, std::istream &addrFile, const raw_sink &sink);
+
+#endif /* NMC_ASSEMBLE_H_ */
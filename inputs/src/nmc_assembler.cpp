@@ -5,16 +5,33 @@
 
 enum class DefaultCmd : int {defaultRD, defaultWR, defaultInherit};
 
+#ifndef NMC_ASSEMBLER_LIB  // Built as part of a tool that runs the assembler in-process
+
 int main(int argc, const char *argv[])
 { 
+    bool binary = take_binary_flag(argc, argv);     // Binary raw sequence instead of text
+
+    // Initial bank contents, for testbenches built with BANK_MODEL. A PIM RD goes without
+    // payload when the bank already holds it: the first RD of a column not written before
+    // is preloaded instead, and later ones only drop a payload equal to the column contents
+    string preloadName;
+    int i, kept = 1;
+    for (i = 1; i < argc; i++) {
+        if (!strncmp(argv[i], "--preload=", 10)) {
+            preloadName = argv[i] + 10;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
     if (argc < 3 || argc > 5) {
-        cout << "Usage: " << argv[0] << " <assembly-input> <raw-output> [<data-input> <address-input]" << endl;
+        cout << "Usage: " << argv[0] << " <assembly-input> <raw-output> [<data-input> <address-input] [--binary] [--preload=<file>]" << endl;
         return 0;
     }
 
     string ai = argv[1];        // Input assembly file name
     string ro = argv[2];        // Output raw hexadecimal code
-    string ailine;
 
     // Open input and output files
     ifstream assembly;
@@ -22,7 +39,7 @@ int main(int argc, const char *argv[])
     ifstream addrFile;
     ofstream rawSeq;
     assembly.open(ai);
-    rawSeq.open(ro);
+    rawSeq.open(ro, binary ? ios::binary : ios::out);
 
     // Prepare data input if needed
     if (argc == 5) {
@@ -32,6 +49,68 @@ int main(int argc, const char *argv[])
         addrFile.open(ad);
     }
 
+    // Preload records are WR commands of a raw trace, in the same format
+    ofstream preloadFile;
+    unique_ptr<trace_writer> preloadWriter;
+    // Contents of the columns preloaded or touched, by address above GLOBAL_OFFSET. Empty
+    // if written by the cores, whose data is not known until simulated
+    unordered_map<uint64_t, vector<uint64_t> > inBanks;
+    uint64_t preloaded = 0, inlineRds = 0;
+    if (!preloadName.empty()) {
+        preloadFile.open(preloadName, binary ? ios::binary : ios::out);
+        preloadWriter.reset(new trace_writer(preloadFile, false, binary));
+    }
+
+    // Commands are written to the raw sequence as they are assembled
+    trace_writer rawWriter(rawSeq, false, binary);
+    nmc_assemble(assembly, dataFile, addrFile, [&](const trace_cmd &cmd) {
+        // The RF writes keep their payload, the PIM RDs leave theirs in the banks if
+        // that is what the banks hold when they are issued
+        if (preloadWriter && !(get_row(cmd.addr) >> (ROW_BITS - 1))) {
+            uint64_t column = cmd.addr >> GLOBAL_OFFSET;
+            auto contents = inBanks.find(column);
+            if (cmd.wr) {
+                inBanks[column].clear();
+            } else if (!cmd.data.empty()) {
+                if (contents == inBanks.end()) {
+                    preloadWriter->write({0, cmd.addr, true, cmd.data});
+                    inBanks[column] = cmd.data;
+                    preloaded++;
+                } else if (contents->second != cmd.data) {
+                    contents->second = cmd.data;    // Kept by the bank model as the new contents
+                    rawWriter.write(cmd);
+                    inlineRds++;
+                    return;
+                }
+                rawWriter.write({0, cmd.addr, false, vector<uint64_t>()});
+                return;
+            }
+        }
+        rawWriter.write(cmd);
+    });
+
+    assembly.close();
+    rawSeq.close();
+    if (preloadWriter) {
+        preloadFile.close();
+        cout << "Preload of " << preloaded << " columns generated, " << inlineRds
+                << " RDs keep their payload (column written or holding other data)" << endl;
+    }
+    if (argc == 5) {
+        dataFile.close();
+        addrFile.close();
+    }
+
+    cout << "Raw sequence generated" << endl;
+
+    return 0;
+}
+
+#endif
+
+bool nmc_assemble(istream &assembly, istream &dataFile, istream &addrFile, const raw_sink &sink)
+{
+    string ailine;
     bool error = false;
     DefaultCmd defaultCmd = DefaultCmd::defaultRD;  // Change here for the defaulr cmd policy
 
@@ -61,7 +140,7 @@ int main(int argc, const char *argv[])
     string memCmd;
     uint16_t lastRow, lastCol;
     string lastMemCmd;
-    uint64_t loopStart, loopEnd, loopNumIter, loopCurrIter;
+    uint64_t loopStart = 0, loopEnd = 0, loopNumIter = 0, loopCurrIter = 0;
 
     // Variables to write the raw sequence
     uint64_t addr;
@@ -191,12 +270,7 @@ int main(int argc, const char *argv[])
                         addr = build_addr({0, 0, 0, 0, row_aux, col_aux}, true);
 
                         // Write command
-                        rawSeq << showbase << hex << addr << "\tWR";
-                        while (!rfData.empty()) {
-                            rawSeq << "\t" << showbase << hex << rfData.front();
-                            rfData.pop_front();
-                        }
-                        rawSeq << endl;
+                        sink({0, addr, true, vector<uint64_t>(rfData.begin(), rfData.end())});
                     }
 
                 break;
@@ -222,7 +296,7 @@ int main(int argc, const char *argv[])
                     addr = build_addr({0, 0, 0, 0, row_aux, col_aux}, true);
 
                     // Write command
-                    rawSeq << showbase << hex << addr << "\tWR\t" << showbase << hex << dataAux << endl;
+                    sink({0, addr, true, {dataAux}});
                 break;
                 
                 // If EXEC, stop IB writing mode and write to output the {A,R/W,D} sequence
@@ -281,29 +355,15 @@ int main(int argc, const char *argv[])
                         lastCol = get_col(addr);
                         lastMemCmd = memCmd;
 
-                        // Write command
-                        rawSeq << showbase << hex << addr << "\t" << memCmd;
-
-                        // Read from data file if needed 
+                        // Read from data file if needed, otherwise the data
+                        // (if any) was in the assembly file
                         if (execInstr.dataFile) {
                             error = getDataFromFile(dataFile, &execInstr);
                             if (error)  break;
-                            while (!execInstr.data.empty()) {
-                                rawSeq << "\t" << showbase << hex << execInstr.data.front();
-                                execInstr.data.pop_front();   // Pop since next iteration has new data
-                            }
-
-                        // Read directly from the structure (data was in assembly file)
-                        } else {
-                            if (!execInstr.data.empty()) {
-                                auto dataItr = execInstr.data.begin();
-                                while (dataItr != execInstr.data.end()) {
-                                    rawSeq << "\t" << showbase << hex << *dataItr;
-                                    ++dataItr;
-                                }
-                            }
                         }
-                        rawSeq << endl;
+
+                        // Write command
+                        sink({0, addr, memCmd == "WR", vector<uint64_t>(execInstr.data.begin(), execInstr.data.end())});
 
                         // Check if we stop execution
                         if (execInstr.ittIdx == MACRO_IDX::EXIT) {
@@ -588,10 +648,9 @@ int main(int argc, const char *argv[])
                     addr = build_addr({0, 0, 0, 0, row_aux, col_aux}, true);
 
                     // Write command
-                    rawSeq << showbase << hex << addr << "\tWR\t";
-                    rawSeq << hex << build_macroinstr (uint(currInstr->ittIdx), currInstr->imm, currInstr->dst, currInstr->src, 
+                    sink({0, addr, true, {build_macroinstr (uint(currInstr->ittIdx), currInstr->imm, currInstr->dst, currInstr->src,
                                                         currInstr->swLen, currInstr->shiftSA, currInstr->rfN, currInstr->src0N, currInstr->src0,
-                                                        currInstr->repack, currInstr->packSta, currInstr->shiftPM, currInstr->dstN, currInstr->dstN) << endl;
+                                                        currInstr->repack, currInstr->packSta, currInstr->shiftPM, currInstr->dstN, currInstr->dstN)}});
 
                     // Advance IB index
                     ibIdx++;
@@ -601,16 +660,7 @@ int main(int argc, const char *argv[])
         }
     }
 
-    assembly.close();
-    rawSeq.close();
-    if (argc == 5) {
-        dataFile.close();
-        addrFile.close();
-    }
-
-    cout << "Raw sequence generated" << endl;
-
-    return 0;
+    return !error;
 }
 
 uint64_t build_addr(vector<uint64_t> addr_vec, bool rf_write)
@@ -652,6 +702,8 @@ bool splitStoreIndex(string* storeTypeString, uint64_t *idx)
     if (split) {
         *storeTypeString = part1;
         *idx = stoll(part2,0,0);
+    } else {    // Registers without index (CSD_LEN, LOOP)
+        *idx = 0;
     }
 
     return split;
@@ -923,7 +975,7 @@ bool getInstData(istringstream &aistream, nmcInst *currInstr) {
     return false;
 }
 
-bool getDataFromFile (ifstream &dataFile, nmcInst *currInstr) {
+bool getDataFromFile (istream &dataFile, nmcInst *currInstr) {
     string diline;
     uint64_t dataAux;
     
@@ -948,7 +1000,7 @@ bool getDataFromFile (ifstream &dataFile, nmcInst *currInstr) {
     return false;
 }
 
-bool getAddrFromFile (ifstream &addrFile, uint64_t *addr) {
+bool getAddrFromFile (istream &addrFile, uint64_t *addr) {
     string ailine;
 
     do {
@@ -11,6 +11,8 @@
 #include <array>
 #include <map>
 #include <random>
+#include <memory>
+#include <unordered_map>
 
 #include "half.hpp"
 #include "../../src/defs.h"
@@ -18,6 +20,7 @@
 #include "../../src/microcode/common_format.h"
 #include "../../src/microcode/base_code.h"
 #include "../../src/microcode/encoded_shift_code.h"
+#include "nmc_assemble.h"
 
 #define DATAFILE    "DataFile"
 #define ADDRFILE    "AddrFile"
@@ -243,7 +246,7 @@ MACRO_IDX inst2ittIdx(INSTR instr, uint imm, string vfuxType, string dst, string
 bool getInstData(istringstream &aistream, nmcInst *currInstr);
 
 // Function to get data from file at execution time, when the loop is executed
-bool getDataFromFile (ifstream &dataFile, nmcInst *currInstr);
+bool getDataFromFile (istream &dataFile, nmcInst *currInstr);
 
 // Function to get address from file at execution time, when the loop is executed
-bool getAddrFromFile (ifstream &addrFile, uint64_t *addr);
\ No newline at end of file
+bool getAddrFromFile (istream &addrFile, uint64_t *addr);
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/tb/pch_main.h"
+#include "../../src/trace_cmd.h"
+#include "nmc_assemble.h"
+#include "ramulator_frontend.h"
+
+using namespace std;
+
+// Same flow as assembly2sc.sh without the intermediate files: the assembler runs in
+// its own thread and hands the raw sequence over through a bounded queue,
+// Ramulator schedules it in the same process and each pseudo-channel driver takes
+// its commands as Ramulator issues them. Only the commands queued or waiting in
+// the controllers are resident.
+// Only the results, and the statistics of Ramulator and the PUs, are written
+
+#define RAW_QUEUE_CMDS  1024    // Raw commands assembled ahead of Ramulator
+
+int sc_main(int argc, char *argv[]) {
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " <ramulator config> <name> [<number of pseudo-channels>]" << endl;
+        return 1;
+    }
+    string name = argv[2];
+    uint numChannels = (argc > 3) ? atoi(argv[3]) : 1;
+    if (numChannels == 0) {
+        cout << "Error: the number of pseudo-channels must be at least 1" << endl;
+        return 1;
+    }
+
+    // Assemble the program into the raw sequence
+    ifstream assembly("INPUTS_DIR/assembly-input/" + name + ".asm");
+    ifstream dataFile("INPUTS_DIR/data-input/" + name + ".data");
+    ifstream addrFile("INPUTS_DIR/address-input/" + name + ".addr");
+    if (!assembly.is_open()) {
+        cout << "Error when opening assembly file " << name << ".asm" << endl;
+        return 1;
+    }
+    queue_trace_source raw(RAW_QUEUE_CMDS);
+
+    // Scheduled by Ramulator as the drivers ask for commands
+    ramulator_frontend frontend(argv[1], "INPUTS_DIR/ramulator-out/" + name + ".stats", raw);
+    if (frontend.error) {
+        return 1;
+    }
+    if (frontend.channels() < numChannels) {
+        cout << "Error: the Ramulator configuration has " << frontend.channels() << " channels" << endl;
+        return 1;
+    }
+
+    sc_clock                                clk("clk", CLK_PERIOD, RESOLUTION);
+    vector<ramulator_channel_source *>      sources(numChannels);
+    vector<pch_channel *>                   channels(numChannels);
+    uint c;
+
+    for (c = 0; c < numChannels; c++) {
+        sources[c] = new ramulator_channel_source(frontend, c);
+        channels[c] = new pch_channel(("pch" + to_string(c)).c_str(), name, c, sources[c]);
+        channels[c]->clk(clk);
+    }
+
+    sc_report_handler::set_actions(SC_ID_VECTOR_CONTAINS_LOGIC_VALUE_,
+            SC_DO_NOTHING);
+
+    // Assembled while the model runs, the raw sequence is never complete in memory
+    uint64_t rawCmds = 0;
+    bool assembled = false;
+    thread assembler([&]() {
+        assembled = nmc_assemble(assembly, dataFile, addrFile, [&](const trace_cmd &cmd) {
+            trace_cmd queued = cmd;
+            raw.push(move(queued));
+            rawCmds++;
+        });
+        raw.close(!assembled);
+    });
+
+    sc_start();
+
+    // The assembler may still be waiting if the simulation stopped early
+    raw.stop();
+    assembler.join();
+    if (assembled) {
+        cout << "Raw sequence generated (" << dec << rawCmds << " commands)" << endl;
+    }
+
+    // Commands scheduled in channels without a driver
+    trace_cmd cmd;
+    for (c = numChannels; c < frontend.channels(); c++) {
+        if (frontend.next(c, cmd)) {
+            cout << "Warning: channel " << c << " has commands but is not simulated" << endl;
+        }
+    }
+
+    return (pch_report(channels, name) || frontend.error || !assembled) ? 1 : 0;
+}
@@ -12,6 +12,8 @@
 #include <random>
 
 #include "../../src/defs.h"
+#include "../../src/trace_cmd.h"
+#include "sci_matcher.h"
 
 using namespace std;
 
@@ -19,33 +21,11 @@ using namespace std;
 // Format of ramulator output:  Cmd     Cycle   Channel Rank    BG  Bank    Row Column
 // Format of SystemC input:     Cycle   Address R/W     Data
 
-struct rawCmd {
-    unsigned long int addr;
-    deque<unsigned long long int> data;
-};
-
-struct chanSeq {
-    deque<rawCmd> readq;
-    deque<rawCmd> writeq;
-    ofstream output;
-};
-
-// Definition of the address mapping
-enum class Level : int {Channel, Rank, BankGroup, Bank, Row, Column, MAX};
-string level_str[int(Level::MAX)] = {"Ch", "Ra", "Bg", "Ba", "Ro", "Co"};
-int addr_bits[int(Level::MAX)] = {CHANNEL_BITS, RANK_BITS, BG_BITS, BANK_BITS, ROW_BITS, COL_BITS};
-Level addr_map[int(Level::MAX)] = {Level::Channel, Level::Column, Level::Rank,
-                        Level::BankGroup, Level::Bank, Level::Row};
-int global_offset = GLOBAL_OFFSET;
-
-unsigned long int build_addr(vector<uint64_t> addr_vec);
-
-unsigned int get_channel(unsigned long int addr);
-
 int main(int argc, const char *argv[])
 {   
+    bool binary = take_binary_flag(argc, argv);     // Binary SystemC inputs instead of text
     if (argc != 5) {
-        cout << "Usage: " << argv[0] << " <raw-sequence> <ramulator-output> <output-file> <number-channels>" << endl;
+        cout << "Usage: " << argv[0] << " <raw-sequence> <ramulator-output> <output-file> <number-channels> [--binary]" << endl;
         return 0;
     }
 
@@ -53,38 +33,47 @@ int main(int argc, const char *argv[])
     string ro = argv[2];    // Input ramulator output file name
     string fo = argv[3];    // Output file name
     unsigned int numChannels = atoi(argv[4]);
-    string rsline, roline;
+    string roline;
     string finalLine = "Simulation done.";  // Start of final line in ramulator output
 
     // Open input files
-    ifstream rawSeq;
+    unique_ptr<trace_source> rawSeq = open_trace_source(rs, false);
     ifstream ramOut;
-    rawSeq.open(rs);
     ramOut.open(ro);
+    if (!rawSeq) {
+        cout << "Error when opening raw sequence " << rs << endl;
+        return 1;
+    }
+
+    // Payloads of the raw commands, read from the raw sequence as needed
+    sci_matcher matcher([&rawSeq](trace_cmd &rawCmd) {
+        if (rawSeq->next(rawCmd)) {
+            return true;
+        }
+        if (rawSeq->error) {
+            cout << "Error when reading raw sequence" << endl;
+        }
+        return false;
+    });
 
     // Create channels and open output files
-    chanSeq channel[numChannels];
+    ofstream output[numChannels];
+    vector<trace_writer> writer;
+    writer.reserve(numChannels);
     for (int i = 0; i < numChannels; i++) {
-        channel[i].output.open(fo + to_string(i));
+        output[i].open(fo + to_string(i), binary ? ios::binary : ios::out);
+        writer.emplace_back(output[i], true, binary);
     }
 
     // Variables for holding ramulator output data
     string ramCmd;
     uint64_t cycle, ch, ra, bg, ba, row, col;
     char colon;
-    unsigned long int ramAddr;
-
-    // Variables for holding raw sequence data
-    unsigned int rsCh;
-    unsigned long int rsAddr, dataAux;
-    deque<unsigned long long int> rsData;
-    string rsCmd;
+    trace_cmd sciCmd;
 
     // Run though the ramulator output
     while (getline(ramOut, roline)) {
 
-        rsData.clear();
-
         // Check that is not last line in the ramulator output
         if (!roline.compare(0, finalLine.size(), finalLine)) {
             cout << "Final line reached" << endl;
@@ -102,117 +91,27 @@ int main(int argc, const char *argv[])
             if (ramCmd.compare("RD") && ramCmd.compare("WR"))
                 continue;
 
-            // Build the address
-            ramAddr = build_addr({ch, ra, bg, ba, row, col});
-
-            // Check in the correct queue if it's not empty
-            bool found = false;
-            if (!ramCmd.compare("RD")) {    // Read queue
-                auto queuedCmd = channel[ch].readq.begin();
-                while (queuedCmd != channel[ch].readq.end() &&
-                        (queuedCmd->addr >> global_offset) != (ramAddr >> global_offset)) {
-                    ++queuedCmd;
-                    
-                }
-                if (queuedCmd != channel[ch].readq.end()) {
-                    rsData = queuedCmd->data;
-                    queuedCmd = channel[ch].readq.erase(queuedCmd);
-                    found = true;
-                }
-            } else {                        // Write queue  
-                auto queuedCmd = channel[ch].writeq.begin();
-                while (queuedCmd != channel[ch].writeq.end() &&
-                        (queuedCmd->addr >> global_offset) != (ramAddr >> global_offset)) {
-                    ++queuedCmd;
-                }
-                if (queuedCmd != channel[ch].writeq.end()) {
-                    rsData = queuedCmd->data;
-                    queuedCmd = channel[ch].writeq.erase(queuedCmd);
-                    found = true;
-                }
-            }
-
-            // If queue empty or not found there, search in the raw sequence
-            while (!found) {
-                if (getline(rawSeq, rsline)) {
-                    istringstream rsiss(rsline);
-                    if (!(rsiss >> hex >> rsAddr >> rsCmd)) {
-                        cout << "Error when reading raw sequence" << endl;
-                        break;
-                    }
-                    while (rsiss >> dataAux) {
-                        rsData.push_back(dataAux);
-                    }
-                    if ((rsAddr >> global_offset) == (ramAddr >> global_offset) &&
-                        !ramCmd.compare(rsCmd)) {
-                        found = true;
-                    } else {
-                        // Extract channel to push to the correct queue
-                        rsCh = get_channel(rsAddr);
-
-                        // Push non-matching commands to the correct queue
-                        rawCmd cmdToQueue = {rsAddr, rsData};
-                        (!rsCmd.compare("RD")) ?
-                            channel[rsCh].readq.push_back(cmdToQueue) :
-                            channel[rsCh].writeq.push_back(cmdToQueue);
-                        rsData.clear();
-                    }
-                } else {
-                    cout << "Error: command not found in raw sequence" << endl;
-                    break;
-                }
-            }
+            // Build the address and look for the payload in the raw sequence
+            sciCmd.cycle = cycle;
+            sciCmd.addr = sci_matcher::build_addr({ch, ra, bg, ba, row, col});
+            sciCmd.wr = ramCmd.compare("RD");
 
             // If not found anywhere, abort the program
-            if (!found)
+            if (!matcher.match(sciCmd.wr, sciCmd.addr, sciCmd.data))
                 break;
 
             // Write to correct output file
-            channel[ch].output << showbase << dec << cycle << "\t" << hex << ramAddr << "\t";
-            channel[ch].output << ramCmd << "\t";
-            while (!rsData.empty()) {
-                channel[ch].output << hex << rsData.front() << "\t";
-                rsData.pop_front();
-            }
-            channel[ch].output << endl;
+            writer[ch].write(sciCmd);
         }
     }
     
-    rawSeq.close();
     ramOut.close();
     for (int i = 0; i < numChannels; i++) {
-        channel[i].output.close();
+        output[i].close();
     }
 
+    cout << "Reorder window: " << dec << matcher.max_pending() << " raw commands" << endl;
     cout << "Program finished" << endl;
 
     return 0;
 }
-
-// Function for building the address using the indices of the different levels
-uint64_t build_addr(vector<uint64_t> addr_vec)
-{
-    uint64_t addr_aux = 0;
-    uint64_t offset = 6; // Don't know really why right now, maybe to address groups of 128
-
-    for (int i = 0; i < int(Level::MAX); i++) {
-        if (addr_bits[int(addr_map[i])]) {
-            addr_aux |= (addr_vec[int(addr_map[i])] << offset);
-            offset += addr_bits[int(addr_map[i])];
-        }
-    }
-
-    return addr_aux;
-}
-
-// Function to get the channel index from an address
-unsigned int get_channel(unsigned long int addr) {
-    unsigned int channel, channelMask;
-    uint offset = 6; // Initial offset
-
-    addr = addr >> offset;  // Remove initial offset
-    channelMask = (1 << addr_bits[int(addr_map[0])]) - 1;
-    channel = addr & channelMask;
-
-    return channel;
-}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+
+#include "Config.h"
+#include "Controller.h"
+#include "Memory.h"
+#include "DRAM.h"
+#include "Request.h"
+#include "Statistics.h"
+#include "HBM2_AB.h"
+
+#include "ramulator_frontend.h"
+#include "sci_matcher.h"
+
+using namespace std;
+using namespace ramulator;
+
+// Main.cpp of Ramulator is not linked
+bool ramulator::warmup_complete = false;
+
+struct ramulator_frontend::state {
+    Config configs;
+    HBM2_AB *spec;
+    vector<Controller<HBM2_AB>*> ctrls;
+    Memory<HBM2_AB, Controller> *memory;
+
+    trace_source &raw;
+    trace_cmd next;                         // Raw command to be sent to the controllers
+    size_t sent = 0;                        // Raw commands sent to the controllers
+    deque<vector<uint64_t> > payloads;      // Payloads of the sent commands, from the oldest one not issued
+    deque<bool> issued;                     // The command of each payload was issued
+    size_t first = 0;                       // Raw index of the first payload kept
+    vector<deque<trace_cmd> > scheduled;    // Commands issued and not consumed yet, per channel
+
+    Request req;
+    bool stall = false, end = false, done = false;
+
+    state(const string &config, trace_source &raw_, unsigned int numChannels) : configs(config), raw(raw_),
+            scheduled(numChannels), req(0, Request::Type::READ, [](Request &r) {}) {}
+};
+
+ramulator_frontend::ramulator_frontend(const string &config, const string &stats, trace_source &raw)
+{
+    Config configs(config);
+    int C = configs.get_channels(), R = configs.get_ranks();
+
+    st = NULL;
+    if (configs["standard"] != "HBM2_AB") {
+        cout << "Error: only the HBM2_AB standard is supported, not " << configs["standard"] << endl;
+        error = true;
+        return;
+    }
+
+    // Same settings as the DRAM trace mode of Ramulator
+    st = new state(config, raw, C);
+    st->configs.add("trace_type", "DRAM");
+    st->configs.add("mapping", "defaultmapping");
+    st->configs.set_core_num(1);
+    Stats::statlist.output(stats);
+
+    // Initiate controllers and memory
+    st->spec = new HBM2_AB(st->configs["org"], st->configs["speed"]);
+    st->spec->set_channel_number(C);
+    st->spec->set_rank_number(R);
+    for (int c = 0; c < C; c++) {
+        DRAM<HBM2_AB>* channel = new DRAM<HBM2_AB>(st->spec, HBM2_AB::Level::Channel);
+        channel->id = c;
+        channel->regStats("");
+        Controller<HBM2_AB>* ctrl = new Controller<HBM2_AB>(st->configs, channel);
+
+        // Issued RD/WR are given their payload and queued in their channel, instead of printed
+        ctrl->print_cmd_trace = false;
+        ctrl->cmd_callback = [this](HBM2_AB::Command cmd, const vector<int> &addr_vec, long clk, const Request *req) {
+            if (!req || (cmd != HBM2_AB::Command::RD && cmd != HBM2_AB::Command::WR)) {
+                return;
+            }
+            uint ch = addr_vec[int(HBM2_AB::Level::Channel)];
+            trace_cmd sciCmd;
+            sciCmd.cycle = clk;
+            sciCmd.addr = sci_matcher::build_addr(vector<uint64_t>(addr_vec.begin(), addr_vec.end()));
+            sciCmd.wr = (cmd == HBM2_AB::Command::WR);
+            // The request carries the index of its raw entry, whose payload is
+            // released once it and the older ones are issued. A payload can only
+            // be taken once, a second RD/WR of the same entry is an error
+            size_t i = size_t(req->payload) - st->first;
+            if (req->payload < 0 || size_t(req->payload) >= st->sent) {
+                cout << "Error: command without payload" << endl;
+                error = true;
+            } else if (size_t(req->payload) < st->first || st->issued[i]) {
+                cout << "Error: payload " << req->payload << " issued twice" << endl;
+                error = true;
+            } else {
+                sciCmd.data = move(st->payloads[i]);
+                st->issued[i] = true;
+                while (!st->issued.empty() && st->issued.front()) {
+                    st->payloads.pop_front();
+                    st->issued.pop_front();
+                    st->first++;
+                }
+            }
+            st->scheduled[ch].push_back(move(sciCmd));
+        };
+        st->ctrls.push_back(ctrl);
+    }
+    st->memory = new Memory<HBM2_AB, Controller>(st->configs, st->ctrls);
+}
+
+ramulator_frontend::~ramulator_frontend()
+{
+    if (st) {
+        delete st->memory;
+        delete st->spec;
+        delete st;
+    }
+}
+
+unsigned int ramulator_frontend::channels() const
+{
+    return st ? st->scheduled.size() : 0;
+}
+
+bool ramulator_frontend::next(unsigned int ch, trace_cmd &cmd)
+{
+    if (!st) {
+        return false;
+    }
+    while (st->scheduled[ch].empty() && !error && tick());
+    if (st->scheduled[ch].empty()) {
+        return false;
+    }
+    cmd = move(st->scheduled[ch].front());
+    st->scheduled[ch].pop_front();
+    return !error;
+}
+
+bool ramulator_frontend::tick()
+{
+    if (st->done) {
+        return false;
+    }
+
+    // Same loop as run_dramtrace, one iteration per call
+    if (!st->end && !st->stall) {
+        st->end = !st->raw.next(st->next);
+        if (st->end && st->raw.error) {
+            cout << "Error when reading the raw sequence" << endl;
+            error = true;
+        }
+    }
+    if (!st->end) {
+        st->req.addr = st->next.addr;
+        st->req.type = st->next.wr ? Request::Type::WRITE : Request::Type::READ;
+        st->req.payload = st->sent;
+        st->stall = !st->memory->send(st->req);
+        if (!st->stall) {
+            st->payloads.push_back(move(st->next.data));
+            st->issued.push_back(false);
+            st->sent++;
+        }
+    } else {
+        st->memory->set_high_writeq_watermark(0.0f);    // make sure that all write requests in the
+                                                        // write queue are drained
+    }
+    st->memory->tick();
+    Stats::curTick++;   // memory clock, global, for Statistics
+
+    if (st->end && !st->memory->pending_requests()) {
+        // This a workaround for statistics set only initially lost in the end
+        st->memory->finish();
+        Stats::statlist.printall();
+        st->done = true;
+    }
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef RAMULATOR_FRONTEND_H_
+#define RAMULATOR_FRONTEND_H_
+
+#include <string>
+
+#include "../../src/trace_cmd.h"
+
+// Ramulator run in the same process as the consumers of its commands. The raw
+// sequence is read from its source and sent to the memory controllers as the
+// consumers ask for commands. Only the payloads of the requests not issued yet are
+// kept: every RD/WR issued takes the payload its request carries the index of, and
+// is queued in its channel.
+// Only the HBM2_AB standard in DRAM trace mode is supported. The Ramulator
+// headers are kept out of this one, so that it can be included in SystemC units
+class ramulator_frontend {
+public:
+    bool error = false;     // The configuration is not supported, the raw sequence could not be read or a command had no payload
+
+    // The payloads of the raw sequence are moved to the scheduled commands
+    ramulator_frontend(const std::string &config, const std::string &stats, trace_source &raw);
+    ~ramulator_frontend();
+
+    // Number of channels of the configuration
+    unsigned int channels() const;
+
+    // Next command scheduled in a channel, ticking the controllers until there is one.
+    // Returns false when the whole sequence has been issued and none is left
+    bool next(unsigned int ch, trace_cmd &cmd);
+
+private:
+    struct state;
+    state *st;
+
+    // One memory cycle, returns false when the simulation is over
+    bool tick();
+};
+
+// Commands of one channel of the frontend
+class ramulator_channel_source: public trace_source {
+public:
+    ramulator_channel_source(ramulator_frontend &frontend_, unsigned int ch_) : frontend(frontend_), ch(ch_) {}
+
+    bool next(trace_cmd &cmd) override {
+        if (error || !frontend.next(ch, cmd)) {
+            error = error || frontend.error;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    ramulator_frontend &frontend;
+    unsigned int ch;
+};
+
+#endif /* RAMULATOR_FRONTEND_H_ */
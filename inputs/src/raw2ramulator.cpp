@@ -10,9 +10,12 @@
 #include <array>
 #include <random>
 
+#include "../../src/trace_cmd.h"
+
 using namespace std;
 
-// Format of raw traces: Address    R/W     Data
+// Format of raw traces: Address    R/W     Data (text or binary)
+// Format of ramulator input: Address  R/W     Index of the entry in the raw trace, the payload handle of the request
 
 int main(int argc, const char *argv[])
 {   
@@ -23,29 +26,26 @@ int main(int argc, const char *argv[])
 
     string fi = argv[1];    // Input file name
     string fo = argv[2];    // Output file name
-    string line;
+    trace_cmd cmd;
+    long index = 0;
 
     // Open input and output files
-    ifstream input;
+    unique_ptr<trace_source> input = open_trace_source(fi, false);
     ofstream output;
-    input.open(fi);
     output.open(fo);
+    if (!input) {
+        cout << "Error when opening input file " << fi << endl;
+        return 1;
+    }
 
     output << showbase << internal << setfill ('0') << hex;
 
     // Run through the sequence of instructions and extract commands for ramulator
-    while (getline(input, line)) {
-        istringstream iss(line);
-        unsigned long int addr;
-        string cmd;
-
-        if (!(iss >> hex >> addr >> cmd)) { break; }   // Error
-
-        output << showbase << internal << setfill ('0') << hex << addr << "\t" << cmd << endl;
+    // The payload is not needed by Ramulator, only its index, which is carried by the request
+    while (input->next(cmd)) {
+        output << showbase << internal << setfill ('0') << hex << cmd.addr << "\t" << (cmd.wr ? "WR" : "RD") << "\t" << dec << index++ << endl;
     }
 
-    
-    input.close();
     output.close();
     return 0;
 }
\ No newline at end of file
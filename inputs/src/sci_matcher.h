@@ -0,0 +1,101 @@
+#ifndef SCI_MATCHER_H_
+#define SCI_MATCHER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "../../src/defs.h"
+#include "../../src/trace_cmd.h"
+
+// Re-associates the RD/WR commands scheduled by Ramulator with the entries of the
+// raw sequence that hold their payload. The raw sequence is read in order until
+// the entry with the same command and address, and the entries skipped on the way
+// are kept by (address, command) in FIFO order, since Ramulator reorders the
+// commands. Each command is matched in constant time, and only the skipped
+// entries (the reorder window) are kept in memory
+class sci_matcher {
+public:
+
+    // Next entry of the raw sequence, false at its end
+    typedef std::function<bool(trace_cmd &)> raw_source;
+
+    sci_matcher(raw_source source_) : source(source_) {}
+
+    // Finds the raw entry of a scheduled command and moves its payload to data.
+    // Returns false if the command is not in the raw sequence
+    bool match(bool wr, uint64_t addr, std::vector<uint64_t> &data) {
+        trace_cmd rawCmd;
+
+        // Check first the entries already read
+        auto queued = pending.find(key(wr, addr));
+        if (queued != pending.end()) {
+            data = std::move(queued->second.front());
+            queued->second.pop_front();
+            if (queued->second.empty()) {
+                pending.erase(queued);
+            }
+            numPending--;
+            return true;
+        }
+
+        // If not found there, search in the raw sequence
+        while (source(rawCmd)) {
+            if (key(rawCmd.wr, rawCmd.addr) == key(wr, addr)) {
+                data = std::move(rawCmd.data);
+                return true;
+            }
+            // Keep non-matching commands for later
+            pending[key(rawCmd.wr, rawCmd.addr)].push_back(std::move(rawCmd.data));
+            numPending++;
+            maxPending = std::max(maxPending, numPending);
+        }
+
+        std::cout << "Error: command not found in raw sequence" << std::endl;
+        return false;
+    }
+
+    // Largest number of raw entries kept at once
+    size_t max_pending() const {
+        return maxPending;
+    }
+
+    // Builds the address from the indices of the different levels (Channel, Rank, BankGroup, Bank, Row, Column)
+    static uint64_t build_addr(const std::vector<uint64_t> &addr_vec) {
+        // Definition of the address mapping
+        enum class LEVEL : int {Channel, Rank, BankGroup, Bank, Row, Column, MAX};
+        static const int ADDR_BITS[int(LEVEL::MAX)] = {CHANNEL_BITS, RANK_BITS, BG_BITS, BANK_BITS, ROW_BITS, COL_BITS};
+        static const LEVEL ADDR_MAP[int(LEVEL::MAX)] = {LEVEL::Channel, LEVEL::Column, LEVEL::Rank,
+                                                        LEVEL::BankGroup, LEVEL::Bank, LEVEL::Row};
+        uint64_t addr_aux = 0;
+        uint64_t offset = GLOBAL_OFFSET;
+
+        for (int i = 0; i < int(LEVEL::MAX); i++) {
+            if (ADDR_BITS[int(ADDR_MAP[i])]) {
+                addr_aux |= (addr_vec[int(ADDR_MAP[i])] << offset);
+                offset += ADDR_BITS[int(ADDR_MAP[i])];
+            }
+        }
+
+        return addr_aux;
+    }
+
+private:
+
+    // Payloads of the raw entries skipped while looking for a match, by command and address
+    std::unordered_map<uint64_t, std::list<std::vector<uint64_t> > > pending;
+    size_t numPending = 0;
+    size_t maxPending = 0;
+    raw_source source;
+
+    // Same address above GLOBAL_OFFSET and same command
+    static uint64_t key(bool wr, uint64_t addr) {
+        return ((addr >> GLOBAL_OFFSET) << 1) | wr;
+    }
+};
+
+#endif /* SCI_MATCHER_H_ */
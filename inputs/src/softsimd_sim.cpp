@@ -0,0 +1,271 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Runs a .sci0 input on the standalone SoftSIMD engine, without SystemC.
+ * Produces the same .results output and final cycle as the pch testbench.
+ * With --channels=N, runs the .sci0 to .sci<N-1> inputs of a trace, one
+ * pseudo-channel per thread, and reports the same statistics as pim-cores.
+ * With --preload=<file>, keeps the bank contents as the pch testbench with
+ * BANK_MODEL: RDs without payload read the preloaded or written columns.
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "../../src/defs.h"
+#include "../../src/softsimd_engine.h"
+#include "../../src/trace_cmd.h"
+#include "../../src/tb/bank_storage.h"
+
+using namespace std;
+
+#if ENGINE_SUPPORTED
+
+// Statistics of a pseudo-channel, same as the pch_driver
+typedef struct channel_stats {
+    uint64_t end_cycle;     // Cycle at which the pseudo-channel finished
+    uint64_t eval_cycles;   // Cycles evaluated by the engine
+    uint64_t commands;      // Commands in the trace
+    uint64_t rf_writes;     // WR commands to the RFs
+    uint64_t pim_reads;     // PIM RD commands
+    uint64_t pim_writes;    // PIM WR commands
+    bool error;             // The trace could not be simulated
+    string log;             // Messages, printed in channel order once all channels are done
+} channel_stats;
+
+// Results file of a pseudo-channel, channel 0 keeps the given name
+static string channel_file(const string &file, uint channel) {
+    size_t dot = file.find_last_of('.');
+    if (!channel) {
+        return file;
+    }
+    if (dot == string::npos || (file.find_last_of('/') != string::npos && dot < file.find_last_of('/'))) {
+        dot = file.size();
+    }
+    return file.substr(0, dot) + "_ch" + to_string(channel) + file.substr(dot);
+}
+
+// Runs a .sci input on its own engine and writes the words sent to the banks. With
+// a preload file, its WRs of this channel are the initial contents of the banks
+static void run_channel(const string &fi, const string &fo, const string &fm, uint channel, channel_stats &stats)
+{
+    ostringstream log;
+
+    stats = {0, 0, 0, 0, 0, 0, false, ""};
+
+    unique_ptr<trace_source> input = open_trace_source(fi, true);
+    if (!input) {
+        stats.log = "Error when opening input file " + fi + "\n";
+        stats.error = true;
+        return;
+    }
+    ofstream output(fo);
+    if (!output.is_open()) {
+        stats.log = "Error when opening output file " + fo + "\n";
+        stats.error = true;
+        return;
+    }
+
+    unique_ptr<softsimd_engine_pch> engine(new softsimd_engine_pch);
+    unique_ptr<uint64_t[][VWR_64B]> bank_out(new uint64_t[CORES_PER_PCH][VWR_64B]);
+    trace_cmd cmd;
+    uint64_t addr, issue_cycle, bank, row, col;
+
+    // Same preload as the pch_driver with BANK_MODEL
+    unique_ptr<bank_storage> banks;
+    if (!fm.empty()) {
+        banks.reset(new bank_storage);
+        unique_ptr<trace_source> preload = open_trace_source(fm, false);
+        if (!preload) {
+            stats.log = "Error when opening preload file " + fm + "\n";
+            stats.error = true;
+            return;
+        }
+        while (preload->next(cmd)) {
+            if (((cmd.addr >> CH_END) & ((1 << CHANNEL_BITS) - 1)) != channel) {
+                continue;
+            }
+            if (!cmd.wr || cmd.data.size() != bank_storage::COL_WORDS) {
+                log << "Error, preload commands must be WR with " << bank_storage::COL_WORDS << " words in " << fm << endl;
+                preload->error = true;
+                break;
+            }
+            bank_storage::locate(cmd.addr, bank, row, col);
+            banks->store(bank, row, col, cmd.data.data());
+        }
+        if (preload->error) {
+            log << "Error when reading preload file " << fm << endl;
+            stats.log = log.str();
+            stats.error = true;
+            return;
+        }
+    }
+
+    // Same input as the pch_driver: cycle, address, command and data
+    while (input->next(cmd)) {
+        stats.commands++;
+
+        bool wr = cmd.wr;
+        addr = cmd.addr;
+        bool rf = (addr >> (RO_STA)) & 1;
+
+        // A PIM RD with payload also sets the column, one without it reads the column
+        if (banks && !rf && !wr) {
+            bank_storage::locate(addr, bank, row, col);
+            if (!cmd.data.empty()) {
+                banks->store(bank, row, col, cmd.data.data());
+            } else if (const uint64_t *words = banks->read(bank, row, col)) {
+                cmd.data.assign(words, words + bank_storage::COL_WORDS);
+            }
+        }
+        issue_cycle = engine->issue(cmd.cycle, addr, wr, cmd.data, bank_out.get());
+        if (rf) {
+            stats.rf_writes += wr;
+        } else if (wr) {
+            stats.pim_writes++;
+        } else {
+            stats.pim_reads++;
+        }
+
+        // PIM WR, record the words sent to the banks
+        if (wr && !rf) {
+            if (banks) {
+                bank_storage::locate(addr, bank, row, col);
+                uint64_t *words = banks->write(bank, row, col);
+                for (uint i = 0; i < CORES_PER_PCH; i++) {
+                    for (uint j = 0; j < VWR_64B; j++) {
+                        words[i*VWR_64B + j] = (64*(j+1) <= VWR_BITS) ? bank_out[i][j] : bank_out[i][j] & packed_lsb_mask(VWR_BITS - 64*j);
+                    }
+                }
+            }
+            output << showbase << dec << issue_cycle << "\t" << hex << addr << "\t";
+            for (uint i = 0; i < CORES_PER_PCH; i++) {
+                for (uint j = 0; j < VWR_64B; j++) {
+                    uint64_t word = (64*(j+1) <= VWR_BITS) ? bank_out[i][j] : bank_out[i][j] & packed_lsb_mask(VWR_BITS - 64*j);
+                    output << showbase << hex << word << "\t";
+                }
+            }
+            output << endl;
+        }
+    }
+
+    if (input->error) {
+        log << "Error when reading input" << endl;
+        stats.error = true;
+    }
+
+    if (!stats.commands) {
+        log << "No lines in the input file " << fi << endl;
+        stats.end_cycle = 1;    // Idle for the whole simulation, as in the pch_driver
+    } else {
+        stats.end_cycle = engine->finish();
+    }
+    stats.eval_cycles = engine->eval_cycles;
+    stats.log += log.str();
+}
+
+int main(int argc, const char *argv[])
+{
+    uint numChannels = 0, numThreads = thread::hardware_concurrency();
+    int i, kept = 1;
+    string preloadFile;
+
+    // Multi-channel options
+    for (i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.find("--channels=") == 0) {
+            numChannels = atoi(arg.substr(11).c_str());
+        } else if (arg.find("--threads=") == 0) {
+            numThreads = atoi(arg.substr(10).c_str());
+        } else if (arg.find("--preload=") == 0) {
+            preloadFile = arg.substr(10);
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
+    if (argc != 3) {
+        cout << "Usage: " << argv[0] << " <sci0 input file> <results output file> [--preload=<mem file>]" << endl;
+        cout << "       " << argv[0] << " --channels=<N> [--threads=<T>] <sci input prefix> <results output file> [...]" << endl;
+        return 1;
+    }
+
+    // Single input, same output as before. An empty input is an idle channel, as with --channels
+    if (!numChannels) {
+        channel_stats stats;
+        run_channel(argv[1], argv[2], preloadFile, 0, stats);
+        cout << stats.log;
+        if (stats.error) {
+            return 1;
+        }
+        cout << "Simulation finished at cycle " << dec << stats.end_cycle << endl;
+        cout << "Evaluated cycles: " << dec << stats.eval_cycles << endl;
+        return 0;
+    }
+
+    // The channels share no state: each thread takes the next channel to simulate,
+    // and everything is reported in channel order once all are done
+    vector<channel_stats> stats(numChannels);
+    vector<thread> workers;
+    atomic<uint> nextChannel(0);
+    numThreads = max(1u, min(numThreads, numChannels));
+    for (uint t = 0; t < numThreads; t++) {
+        workers.emplace_back([&]() {
+            uint c;
+            while ((c = nextChannel++) < numChannels) {
+                run_channel(string(argv[1]) + to_string(c), channel_file(argv[2], c), preloadFile, c, stats[c]);
+            }
+        });
+    }
+    for (thread &w : workers) {
+        w.join();
+    }
+
+    uint64_t maxCycle = 0, sumCycle = 0;
+    channel_stats total = {0, 0, 0, 0, 0, 0, false, ""};
+    for (uint c = 0; c < numChannels; c++) {
+        cout << stats[c].log;
+        maxCycle = MAX(maxCycle, stats[c].end_cycle);
+        sumCycle += stats[c].end_cycle;
+        total.eval_cycles += stats[c].eval_cycles;
+        total.rf_writes += stats[c].rf_writes;
+        total.pim_reads += stats[c].pim_reads;
+        total.pim_writes += stats[c].pim_writes;
+        total.error |= stats[c].error;
+    }
+    cout << "Simulation finished at cycle " << dec << maxCycle << endl;
+    cout << "Channel\tEnd cycle\tRF WR\tPIM RD\tPIM WR\tEvaluated" << endl;
+    for (uint c = 0; c < numChannels; c++) {
+        cout << c << "\t" << stats[c].end_cycle << "\t" << stats[c].rf_writes << "\t" << stats[c].pim_reads << "\t"
+                << stats[c].pim_writes << "\t" << stats[c].eval_cycles << (stats[c].error ? "\tERROR" : "") << endl;
+    }
+    cout << "All\t" << maxCycle << "\t" << total.rf_writes << "\t" << total.pim_reads << "\t"
+            << total.pim_writes << "\t" << total.eval_cycles << endl;
+    cout << "Load imbalance (max/mean end cycle): " << fixed << setprecision(3)
+            << (sumCycle ? double(maxCycle) * numChannels / sumCycle : 1.0) << endl;
+
+    return total.error ? 1 : 0;
+}
+
+#else
+
+int main(int argc, const char *argv[])
+{
+    cout << "The standalone engine does not support this configuration" << endl;
+    return 1;
+}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Randomized check of the word-parallel (SWAR) subword operations against
+ * references that handle one subword at a time: additions and subtractions
+ * of the Shift & Add stage, right shifts with sign extension, and the
+ * data_pack repacking. Every subword size of SWSIZE is covered, plus sizes
+ * without precomputed masks or plans.
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../../src/defs.h"
+#include "../../src/opcodes.h"
+#include "../../src/packed_bits.h"
+#include "../../src/swar_ops.h"
+
+using namespace std;
+
+// Subword sizes checked: those of SWSIZE and some without precomputed masks
+static const uint SIZES[] = {3, 4, 6, 8, 12, 16, 24, 5, 7, 32, 48};
+
+// Each subword is ((op1 ^ inv1) + (op2 ^ inv2) + carry) within its size, with
+// the carry in only if an operand is negated
+static void ref_sa_add(const uint64_t *op1, const uint64_t *op2, uint64_t *out, uint size, bool neg_op1, bool neg_op2) {
+    uint64_t carry = neg_op1 || neg_op2;
+
+    memset(out, 0, WORD_64B*sizeof(uint64_t));
+    for (uint i = 0; i < WORD_BITS/size; i++) {
+        uint64_t a = packed_get(op1, i*size, size) ^ (neg_op1 ? packed_lsb_mask(size) : 0);
+        uint64_t b = packed_get(op2, i*size, size) ^ (neg_op2 ? packed_lsb_mask(size) : 0);
+        packed_set(out, i*size, size, (a + b + carry) & packed_lsb_mask(size));
+    }
+}
+
+// Arithmetic right shift of each subword, bypass if shift is zero or above max_shift
+static void ref_right_shift(const uint64_t *in, uint64_t *out, uint shift, uint size, uint max_shift) {
+    memcpy(out, in, WORD_64B*sizeof(uint64_t));
+    if (shift > max_shift || shift == 0) {
+        return;
+    }
+    for (uint i = 0; i < WORD_BITS/size; i++) {
+        int64_t sw = int64_t(packed_get(in, i*size, size) << (64 - size)) >> (64 - size);
+        sw >>= (shift < size) ? shift : size - 1;
+        packed_set(out, i*size, size, uint64_t(sw) & packed_lsb_mask(size));
+    }
+}
+
+// Same as bv_data_pack, one output subword at a time
+static void ref_repack(const uint64_t *w1, const uint64_t *w2, uint64_t *out, uint in_size, uint out_size, uint in_start) {
+    uint i, j, in_idx;
+    const uint64_t *src;
+
+    if (in_size > MASK_BITS || out_size > MASK_BITS || in_size == 0 || out_size == 0
+        || in_start >= 2*(MASK_BITS/in_size)) {
+        memcpy(out, w1, WORD_64B*sizeof(uint64_t));
+        return;
+    }
+
+#if !LOCAL_REPACK
+    const uint chunks = 1, chunk_bits = WORD_BITS;
+#else
+    const uint chunks = MASK_PER_WORD, chunk_bits = MASK_BITS;
+#endif
+    memset(out, 0, WORD_64B*sizeof(uint64_t));
+    for (i = 0; i < chunks; i++) {
+        for (j = 0; j < chunk_bits/out_size; j++) {
+            in_idx = (j + in_start) % (2*(chunk_bits/in_size));
+            src = (in_idx >= chunk_bits/in_size) ? w2 : w1;
+            in_idx %= chunk_bits/in_size;
+            if (in_size < out_size) {
+                packed_set(out, i*chunk_bits + (j+1)*out_size - in_size, in_size,
+                           packed_get(src, i*chunk_bits + in_idx*in_size, in_size));
+            } else {
+                packed_set(out, i*chunk_bits + j*out_size, out_size,
+                           packed_get(src, i*chunk_bits + (in_idx+1)*in_size - out_size, out_size));
+            }
+        }
+    }
+}
+
+// Random word, with runs of all-zero and all-one subwords to exercise the carries and signs
+static void random_word(mt19937_64 &rng, uint64_t *w) {
+    for (uint i = 0; i < WORD_64B; i++) {
+        switch (rng() % 4) {
+            case 0:     w[i] = 0;                   break;
+            case 1:     w[i] = ~(uint64_t) 0;       break;
+            default:    w[i] = rng();               break;
+        }
+    }
+}
+
+// Compares the bits of the whole subwords, those above the last one depend on the datapath
+static bool report(const string &op, uint size, uint arg, const uint64_t *got, const uint64_t *exp) {
+    uint bits = (WORD_BITS/size) * size;
+
+    for (uint i = 0; i < WORD_64B && 64*i < bits; i++) {
+        uint64_t mask = (64*(i+1) <= bits) ? ~(uint64_t) 0 : packed_lsb_mask(bits - 64*i);
+        if ((got[i] ^ exp[i]) & mask) {
+            printf("%s mismatch: size %u, argument %u, lane %u: 0x%016lx instead of 0x%016lx\n",
+                   op.c_str(), size, arg, i, (unsigned long) got[i], (unsigned long) exp[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, const char *argv[])
+{
+    uint iterations = 1000, seed = 1, failed = 0;
+    uint64_t op1[WORD_64B], op2[WORD_64B], got[WORD_64B], exp[WORD_64B];
+
+    if (argc > 3) {
+        cout << "Usage: " << argv[0] << " [<iterations>] [<seed>]" << endl;
+        return 1;
+    }
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        seed = atoi(argv[2]);
+    }
+    mt19937_64 rng(seed);
+
+    for (uint it = 0; it < iterations && failed < 10; it++) {
+        for (uint size : SIZES) {
+            random_word(rng, op1);
+            random_word(rng, op2);
+
+            // Shift & Add stage, also with out aliasing op1
+            for (uint neg = 0; neg < 4; neg++) {
+                ref_sa_add(op1, op2, exp, size, neg & 1, neg & 2);
+                swar_sa_add(op1, op2, got, size, neg & 1, neg & 2);
+                failed += !report("sa_add", size, neg, got, exp);
+                memcpy(got, op1, sizeof(got));
+                swar_sa_add(got, op2, got, size, neg & 1, neg & 2);
+                failed += !report("sa_add (aliased)", size, neg, got, exp);
+            }
+
+            // Right shifts, up to the largest one of the datapath and beyond the subword
+            for (uint shift = 0; shift <= SWAR_MAX_SHIFT + 1; shift++) {
+                ref_right_shift(op1, exp, shift, size, SWAR_MAX_SHIFT);
+                swar_right_shift(op1, got, shift, size, SWAR_MAX_SHIFT);
+                failed += !report("right_shift", size, shift, got, exp);
+            }
+
+            // Repacking to every other size, from a random start position
+            if (size <= MASK_BITS) {
+                for (uint out_size : SIZES) {
+                    uint in_start = rng() % (2*(MASK_BITS/size) + 1);
+                    ref_repack(op1, op2, exp, size, out_size, in_start);
+                    swar_repack(op1, op2, got, size, out_size, in_start);
+                    failed += !report("repack from " + to_string(size), out_size, in_start, got, exp);
+                }
+            }
+        }
+    }
+
+    if (failed) {
+        cout << failed << " mismatches" << endl;
+        return 1;
+    }
+    cout << "SWAR operations match the subword references (" << iterations << " iterations, seed " << seed << ")" << endl;
+    return 0;
+}
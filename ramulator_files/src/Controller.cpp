@@ -152,7 +152,7 @@ void Controller<TLDRAM>::tick(){
 
     // issue command on behalf of request
     auto cmd = get_first_cmd(req);
-    issue_cmd(cmd, get_addr_vec(cmd, req));
+    issue_cmd(cmd, get_addr_vec(cmd, req), &*req);
 
     // check whether this is the last command (which finishes the request)
     if (cmd != channel->spec->translate[int(req->type)])
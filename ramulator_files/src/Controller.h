@@ -5,6 +5,7 @@
 #include <cstdio>
 #include <deque>
 #include <fstream>
+#include <functional>
 #include <list>
 #include <string>
 #include <vector>
@@ -103,6 +104,9 @@ public:
     bool record_cmd_trace = false;
     /* Commands to stdout */
     bool print_cmd_trace = false;
+    /* Commands to an in-process consumer (command, address vector, issue cycle and
+       request on whose behalf it is issued, NULL for speculative precharges) */
+    function<void(typename T::Command, const vector<int>&, long, const Request*)> cmd_callback;
 
     /* Constructor */
     Controller(const Config& configs, DRAM<T>* channel) :
@@ -455,7 +459,7 @@ public:
         }
 
         // issue command on behalf of request
-        issue_cmd(cmd, get_addr_vec(cmd, req));
+        issue_cmd(cmd, get_addr_vec(cmd, req), &*req);
 
         // check whether this is the last command (which finishes the request)
         //if (cmd != channel->spec->translate[int(req->type)]){
@@ -596,7 +600,7 @@ public:
         }
 
         // issue command on behalf of request
-        issue_cmd(cmd, get_addr_vec(cmd, req));
+        issue_cmd(cmd, get_addr_vec(cmd, req), &*req);
 
         // check whether this is the last command (which finishes the request)
         //if (cmd != channel->spec->translate[int(req->type)]){
@@ -773,7 +777,7 @@ private:
 
     }
 
-    void issue_cmd(typename T::Command cmd, const vector<int>& addr_vec)
+    void issue_cmd(typename T::Command cmd, const vector<int>& addr_vec, const Request* req = NULL)
     {
         cmd_issue_autoprecharge(cmd, addr_vec);
         assert(is_ready(cmd, addr_vec));
@@ -807,6 +811,9 @@ private:
                 printf(" %5d", addr_vec[lev]);
             printf("\n");
         }
+        if (cmd_callback){
+            cmd_callback(cmd, addr_vec, clk, req);
+        }
     }
     vector<int> get_addr_vec(typename T::Command cmd, list<Request>::iterator req){
         return req->addr_vec;
@@ -10,7 +10,10 @@
 #include <cstring>
 #include <stdlib.h>
 #include <functional>
+#include <fstream>
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 /* Standards */
 #include "Gem5Wrapper.h"
@@ -38,21 +41,134 @@
 #include "RRAM_AB.h"
 #include "STTRAM_AB.h"
 
+/* SystemC inputs of the SideDRAM model */
+#include "../../inputs/src/sci_matcher.h"
+#include "../../src/trace_cmd.h"
+
 using namespace std;
 using namespace ramulator;
 
 bool ramulator::warmup_complete = false;
 
+// SystemC inputs (.sci<channel>) written as the RD/WR commands are issued, with the
+// payload of their entry in the raw sequence, instead of printing them for ramulator2sc.
+// Written in the format of the raw sequence, text or binary
+template<typename T>
+class SciOutput {
+public:
+    bool enabled = false;
+
+    SciOutput(const Config& configs, Memory<T, Controller>& memory, const char* tracename) {
+        if (configs["sci_out"] == "")
+            return;
+        if (configs["standard"] != "HBM2_AB") {
+            printf("SystemC inputs are only supported for HBM2_AB\n");
+            exit(1);
+        }
+        raw = open_trace_source(configs["sci_raw"], false);
+        if (!raw) {
+            printf("Error when opening raw sequence %s\n", configs["sci_raw"].c_str());
+            exit(1);
+        }
+        bool binary = is_bin_trace(configs["sci_raw"]);
+        trace.open(tracename);
+        if (!trace.good()) {
+            printf("Bad trace file: %s\n", tracename);
+            exit(1);
+        }
+
+        // RD and WR, as named in the printed command trace
+        Controller<T>* ctrl0 = memory.ctrls[0];
+        for (int c = 0; c < int(T::Command::MAX); c++) {
+            if (ctrl0->channel->spec->command_name[c] == "RD") rd = typename T::Command(c);
+            if (ctrl0->channel->spec->command_name[c] == "WR") wr = typename T::Command(c);
+        }
+
+        for (auto ctrl : memory.ctrls) {
+            outputs.emplace_back(new ofstream(configs["sci_out"] + to_string(ctrl->channel->id), binary ? ios::binary : ios::out));
+            writers.emplace_back(*outputs.back(), true, binary);
+            ctrl->print_cmd_trace = false;
+            ctrl->cmd_callback = [this](typename T::Command cmd, const vector<int>& addr_vec, long clk, const Request* req) {
+                issue(cmd, addr_vec, clk, req);
+            };
+        }
+        enabled = true;
+    }
+
+    ~SciOutput() {
+        for (auto output : outputs)
+            delete output;
+    }
+
+    // DRAM trace with the payload index as a third column (Address R/W Index), as written
+    // by raw2ramulator. Without it, the payload is the entry at the same position
+    bool get_request(long& req_addr, Request::Type& req_type, long& payload) {
+        string line;
+        while (getline(trace, line) && line.find_first_not_of(" \t\r") == string::npos);
+        if (!trace)
+            return false;
+
+        char* end;
+        req_addr = strtoul(line.c_str(), &end, 16);
+        while (*end == ' ' || *end == '\t') end++;
+        req_type = (*end == 'W') ? Request::Type::WRITE : Request::Type::READ;
+        while (*end && *end != ' ' && *end != '\t') end++;
+        char* index_end;
+        payload = strtol(end, &index_end, 10);
+        if (index_end == end)
+            payload = requests;
+        requests++;
+        return true;
+    }
+
+private:
+    unique_ptr<trace_source> raw;
+    ifstream trace;
+    long requests = 0;                                  // Requests read from the trace
+    long rawRead = 0;                                   // Entries read from the raw sequence
+    unordered_map<long, vector<uint64_t>> payloads;     // Read and not issued yet, by index
+    vector<ofstream*> outputs;
+    vector<trace_writer> writers;
+    typename T::Command rd, wr;
+
+    void issue(typename T::Command cmd, const vector<int>& addr_vec, long clk, const Request* req) {
+        if (!req || (cmd != rd && cmd != wr))
+            return;
+
+        trace_cmd sciCmd;
+        sciCmd.cycle = clk;
+        sciCmd.addr = sci_matcher::build_addr(vector<uint64_t>(addr_vec.begin(), addr_vec.end()));
+        sciCmd.wr = (cmd == wr);
+
+        // The payload travels with the request, the raw sequence is only read up to it
+        trace_cmd rawCmd;
+        while (rawRead <= req->payload && !payloads.count(req->payload) && raw->next(rawCmd))
+            payloads[rawRead++] = move(rawCmd.data);
+        auto found = payloads.find(req->payload);
+        if (found == payloads.end()) {
+            printf("Error: payload %ld of a %s is not in the raw sequence\n", req->payload, sciCmd.wr ? "WR" : "RD");
+            exit(1);
+        }
+        sciCmd.data = move(found->second);
+        payloads.erase(found);
+        writers[addr_vec[int(T::Level::Channel)]].write(sciCmd);
+    }
+};
+
 template<typename T>
 void run_dramtrace(const Config& configs, Memory<T, Controller>& memory, const char* tracename) {
 
     /* initialize DRAM trace */
     Trace trace(tracename);
 
+    /* RD/WR commands to the SystemC inputs, if requested */
+    SciOutput<T> sci(configs, memory, tracename);
+
     /* run simulation */
     bool stall = false, end = false;
     int reads = 0, writes = 0, clks = 0;
     long addr = 0;
+    long payload = -1;
     Request::Type type = Request::Type::READ;
     map<int, int> latencies;
     auto read_complete = [&latencies](Request& r){latencies[r.depart - r.arrive]++;};
@@ -61,12 +177,13 @@ void run_dramtrace(const Config& configs, Memory<T, Controller>& memory, const c
 
     while (!end || memory.pending_requests()){
         if (!end && !stall){
-            end = !trace.get_dramtrace_request(addr, type);
+            end = sci.enabled ? !sci.get_request(addr, type, payload) : !trace.get_dramtrace_request(addr, type);
         }
 
         if (!end){
             req.addr = addr;
             req.type = type;
+            req.payload = payload;
             stall = !memory.send(req);
             if (!stall){
                 if (type == Request::Type::READ) reads++;
@@ -184,11 +301,16 @@ void start_run(const Config& configs, T* spec, const vector<const char*>& files)
   }
 }
 
+static void print_usage(const char *prog)
+{
+    printf("Usage: %s <configs-file> --mode=cpu,dram [--stats <filename>] [--mapping <filename>] [--sci <raw-sequence> <output-prefix>] <trace-filename1> <trace-filename2>\n"
+        "Example: %s ramulator-configs.cfg --mode=cpu cpu.trace cpu.trace\n", prog, prog);
+}
+
 int main(int argc, const char *argv[])
 {
     if (argc < 2) {
-        printf("Usage: %s <configs-file> --mode=cpu,dram [--stats <filename>] <trace-filename1> <trace-filename2>\n"
-            "Example: %s ramulator-configs.cfg --mode=cpu cpu.trace cpu.trace\n", argv[0], argv[0]);
+        print_usage(argv[0]);
         return 0;
     }
 
@@ -227,6 +349,18 @@ int main(int argc, const char *argv[])
       configs.add("mapping", "defaultmapping");
     }
 
+    // SystemC inputs written directly, DRAM mode only: --sci <raw-sequence> <output-prefix>
+    if (trace_start < argc && strcmp(argv[trace_start], "--sci") == 0) {
+      if (trace_start + 2 >= argc) {
+        printf("--sci needs a raw sequence and an output prefix\n");
+        print_usage(argv[0]);
+        return 1;
+      }
+      configs.add("sci_raw", argv[trace_start+1]);
+      configs.add("sci_out", argv[trace_start+2]);
+      trace_start += 3;
+    }
+
     std::vector<const char*> files(&argv[trace_start], &argv[argc]);
     configs.set_core_num(argc - trace_start);
 
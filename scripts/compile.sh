@@ -5,4 +5,5 @@ cd $SIDEDRAM_HOME
 cd inputs
 ./compile_all.sh
 make -C ../Debug/ all -j32
+./compile_pipeline.sh
 cd ..
\ No newline at end of file
@@ -15,4 +15,5 @@ INPUTS_SED=$(echo $INPUTS_DIR | sed 's/\//\\\//g')
 sed -i "s/INPUTS_DIR/$INPUTS_SED/g" $SIDEDRAM_HOME/inputs/src/gen_gemm_assembly.cpp
 sed -i "s/INPUTS_DIR/$INPUTS_SED/g" $SIDEDRAM_HOME/inputs/src/map_kernel.cpp
 sed -i "s/INPUTS_DIR/$INPUTS_SED/g" $SIDEDRAM_HOME/src/control_unit.cpp
-sed -i "s/INPUTS_DIR/$INPUTS_SED/g" $SIDEDRAM_HOME/src/tb/pch_driver.cpp
\ No newline at end of file
+sed -i "s/INPUTS_DIR/$INPUTS_SED/g" $SIDEDRAM_HOME/src/tb/pch_driver.cpp
+sed -i "s/INPUTS_DIR/$INPUTS_SED/g" $SIDEDRAM_HOME/inputs/src/pim_pipeline.cpp
\ No newline at end of file
@@ -7,9 +7,23 @@
  */
 
 #include "add_sub.h"
+#include "swar_ops.h"
 
 void add_sub::comb_method() {
     uint i;
+#ifndef __SYNTHESIS__
+    uint64_t        op1_temp[WORD_64B], op2_temp[WORD_64B], out_temp[WORD_64B];
+
+    for (i = 0; i < WORD_64B; i++) {
+        op1_temp[i] = op1[i];
+        op2_temp[i] = op2[i];
+    }
+
+    swar_add_sub(op1_temp, op2_temp, out_temp, neg_op1, neg_op2);
+
+    for (i = 0; i < WORD_64B; i++)
+        output[i]->write(out_temp[i]);
+#else
     uint64_t        out_temp;
     sc_biguint<65>  op1_aux, op2_aux, res_aux;
     sc_uint<64>     parse_aux;
@@ -25,4 +39,5 @@ void add_sub::comb_method() {
         out_temp = parse_aux.to_uint64();
         output[i]->write(out_temp);
     }
+#endif
 }
@@ -11,6 +11,7 @@
 
 #include "systemc.h"
 #include "cnm_base.h"
+#include "swar_ops.h"
 
 class adder_msb_set: public sc_module {
 public:
@@ -35,6 +36,20 @@ public:
     // Set the correct subword MSBs after addition/subtraction
     void comb_method() {
         uint i;
+#ifndef __SYNTHESIS__
+        uint64_t            op1_temp[WORD_64B], op2_temp[WORD_64B], ao_temp[WORD_64B], out_temp[WORD_64B];
+
+        for (i = 0; i < WORD_64B; i++) {
+            op1_temp[i] = op1[i];
+            op2_temp[i] = op2[i];
+            ao_temp[i] = add_out[i];
+        }
+
+        swar_msb_set(op1_temp, op2_temp, ao_temp, out_temp, size, neg_op1, neg_op2);
+
+        for (i = 0; i < WORD_64B; i++)
+            output[i]->write(out_temp[i]);
+#else
         sc_bv<64>           parse_aux;  // Used for parsing
         sc_bv<WORD_64B*64>  op1_aux;    // Holds casted op1
         sc_bv<WORD_64B*64>  op2_aux;    // Holds casted op2
@@ -56,17 +71,7 @@ public:
                 ao_aux.range((i+1)*64-1, i*64) = parse_aux;
             }
 
-#ifndef __SYNTHESIS__
-            out_aux = ao_aux;
-
-            // Set the correct MSB for each subword
-            for (i = 0; i < WORD_BITS/size; i++) {
-                uint gb_idx = (i+1)*size-1;
-                out_aux[gb_idx] = op1_aux[gb_idx] ^ op2_aux[gb_idx] ^ ao_aux[gb_idx];
-            }
-#else
             set_msb_switch(op1_aux, op2_aux, ao_aux, out_aux, size);
-#endif
 
             // Parse SystemC result to output
             for (i = 0; i < WORD_64B; i++) {
@@ -79,7 +84,7 @@ public:
             for (i = 0; i < WORD_64B; i++)
                 output[i]->write(add_out[i]);
         }
-
+#endif
     }
 
 #ifdef __SYNTHESIS__
@@ -12,6 +12,7 @@
 #include "systemc.h"
 
 #include "cnm_base.h"
+#include "swar_ops.h"
 
 class and_or_guardbits: public sc_module {
 public:
@@ -36,10 +37,16 @@ public:
 
         uint i;
         uint64_t            out_temp[WORD_64B];
+#ifndef __SYNTHESIS__
+        uint64_t            in_temp[WORD_64B];
+
+        for (i = 0; i < WORD_64B; i++)
+            in_temp[i] = input[i];
+
+        swar_and_or_guardbits(in_temp, out_temp, size->read(), gb_to_one->read());
+#else
         sc_bv<64>           parse_aux;
-        sc_bv<WORD_64B*64>  in_aux, out_aux, mask_aux;
-        sc_bv<WORD_64B*64>  zeros('0');
-        sc_bv<WORD_64B*64>  ones('1');
+        sc_bv<WORD_64B*64>  in_aux, out_aux;
 
         // Parse input to SystemC types
         for (i = 0; i < WORD_64B; i++) {
@@ -49,25 +56,7 @@ public:
 
         // If size is not invalid
         if (size->read()) {
-#ifndef __SYNTHESIS__
-            if (gb_to_one->read()) {
-                // Create and OR mask for subtracting
-                mask_aux = zeros;
-                for (i = 0; i < WORD_BITS/size; i++) {
-                    mask_aux[(i+1)*size-1] = '1';
-                }
-                out_aux = in_aux | mask_aux;
-            } else {
-                // Create and AND mask for adding
-                mask_aux = ones;
-                for (i = 0; i < WORD_BITS/size; i++) {
-                    mask_aux[(i+1)*size-1] = '0';
-                }
-                out_aux = in_aux & mask_aux;
-            }
-#else
             mask_guardbits_switch(in_aux, out_aux, size->read(), gb_to_one->read());
-#endif
         } else {
             out_aux = in_aux;
         }
@@ -77,6 +66,7 @@ public:
             parse_aux.range(63,0) = out_aux.range((i+1)*64-1, i*64);
             out_temp[i] = parse_aux.to_uint64();
         }
+#endif
 
         // Write to output
         for (i = 0; i < WORD_64B; i++) {
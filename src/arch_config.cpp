@@ -0,0 +1,145 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Implementation of the runtime architecture configuration
+ *
+ */
+
+#include "arch_config.h"
+
+#include <fstream>
+#include <sstream>
+
+// Parameters by name, with their value in defs.h
+typedef struct arch_param {
+    const char *name;
+    uint arch_config::*field;
+    uint built;
+} arch_param;
+
+static const arch_param ARCH_PARAMS[] = {
+    { "WORD_BITS",      &arch_config::word_bits,        WORD_BITS },
+    { "VWR_BITS",       &arch_config::vwr_bits,         VWR_BITS },
+    { "MASK_BITS",      &arch_config::mask_bits,        MASK_BITS },
+    { "CSD_BITS",       &arch_config::csd_bits,         CSD_BITS },
+    { "CORES_PER_PCH",  &arch_config::cores_per_pch,    CORES_PER_PCH },
+    { "DRAM_BITS",      &arch_config::dram_bits,        DRAM_BITS },
+    { "VWR_NUM",        &arch_config::vwr_num,          VWR_NUM },
+    { "REG_NUM",        &arch_config::reg_num,          REG_NUM },
+    { "IB_ENTRIES",     &arch_config::ib_entries,       IB_ENTRIES },
+    { "CSD_ENTRIES",    &arch_config::csd_entries,      CSD_ENTRIES },
+    { "SRF_ENTRIES",    &arch_config::srf_entries,      SRF_ENTRIES },
+    { "MASK_ENTRIES",   &arch_config::mask_entries,     MASK_ENTRIES },
+    { "SA_MAX_SHIFT",   &arch_config::sa_max_shift,     SA_MAX_SHIFT },
+    { "PM_MAX_SHIFT",   &arch_config::pm_max_shift,     PM_MAX_SHIFT },
+};
+
+static const arch_param *find_param(const std::string &name) {
+    for (const arch_param &p : ARCH_PARAMS) {
+        if (name == p.name) {
+            return &p;
+        }
+    }
+    return NULL;
+}
+
+arch_config::arch_config() {
+    for (const arch_param &p : ARCH_PARAMS) {
+        this->*p.field = p.built;
+    }
+}
+
+bool arch_config::set(const std::string &name, uint64_t value) {
+    const arch_param *p = find_param(name);
+    if (p) {
+        this->*p->field = value;
+    }
+    return p;
+}
+
+bool arch_config::load(const std::string &file) {
+    std::ifstream input(file);
+    std::string line, name;
+    uint64_t value;
+    uint n_line = 0;
+
+    if (!input.is_open()) {
+        std::cout << "Error when opening configuration file " << file << std::endl;
+        return false;
+    }
+
+    while (getline(input, line)) {
+        n_line++;
+        std::istringstream iss(line);
+        if (!(iss >> name) || name.at(0) == ';' || name.at(0) == '/' || name.at(0) == '*' || (name.at(0) == '#' && name != "#define")) {
+            continue;   // Empty or comment line (also C comments and preprocessor lines of a defs.h)
+        }
+        if (name == "#define" && !(iss >> name)) {
+            continue;
+        }
+        if (!(iss >> value)) {
+            // Defines that are not plain numbers (flags, derived values) are not parameters
+            if (line.find("#define") == std::string::npos) {
+                std::cout << "Error when reading the value of " << name << " at line " << n_line << " of " << file << std::endl;
+                return false;
+            }
+            continue;
+        }
+        if (!set(name, value) && line.find("#define") == std::string::npos) {
+            std::cout << "Unknown parameter " << name << " at line " << n_line << " of " << file << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool arch_config::parse_args(int &argc, const char **argv) {
+    int i, kept = 1;
+    bool ok = true;
+
+    for (i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        if (arg.find("--config=") == 0) {
+            ok &= load(arg.substr(9));
+        } else if (arg.find("--") == 0 && eq != std::string::npos && find_param(arg.substr(2, eq - 2))) {
+            try {
+                set(arg.substr(2, eq - 2), std::stoull(arg.substr(eq + 1), 0, 0));
+            } catch (const std::exception &e) {
+                std::cout << "Error when reading the value of " << arg << std::endl;
+                ok = false;
+            }
+        } else {
+            argv[kept++] = argv[i];     // Not a configuration argument, keep it
+        }
+    }
+    argc = kept;
+
+    return ok && check(std::cout);
+}
+
+bool arch_config::check(std::ostream &err) const {
+    for (const arch_param &p : ARCH_PARAMS) {
+        if (!(this->*p.field) && p.field != &arch_config::sa_max_shift && p.field != &arch_config::pm_max_shift) {
+            err << "Configuration error: " << p.name << " cannot be zero" << std::endl;
+            return false;
+        }
+    }
+    if (vwr_bits < word_bits) {
+        err << "Configuration error: VWR_BITS (" << vwr_bits << ") is smaller than WORD_BITS (" << word_bits << ")" << std::endl;
+        return false;
+    }
+    if (word_bits < mask_bits) {
+        err << "Configuration error: WORD_BITS (" << word_bits << ") is smaller than MASK_BITS (" << mask_bits << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void arch_config::print(std::ostream &os) const {
+    for (const arch_param &p : ARCH_PARAMS) {
+        os << p.name << " " << std::dec << this->*p.field << std::endl;
+    }
+}
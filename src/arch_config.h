@@ -0,0 +1,62 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Runtime description of an architecture point. Defaults to the values in
+ * defs.h, and can be loaded from a configuration file (NAME value lines, also
+ * accepting #define lines) or from --NAME=value arguments. Only for the tools
+ * that compute with the parameters, like the GEMM mapping and its models: the
+ * instruction encoding and the SystemC model keep the sizes of defs.h.
+ *
+ */
+
+#ifndef SRC_ARCH_CONFIG_H_
+#define SRC_ARCH_CONFIG_H_
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "defs.h"
+
+class arch_config {
+public:
+
+    // Sizing parameters, same names as in defs.h
+    uint word_bits;
+    uint vwr_bits;
+    uint mask_bits;
+    uint csd_bits;
+    uint cores_per_pch;
+    uint dram_bits;
+    uint vwr_num;
+    uint reg_num;
+    uint ib_entries;
+    uint csd_entries;
+    uint srf_entries;
+    uint mask_entries;
+    uint sa_max_shift;
+    uint pm_max_shift;
+
+    arch_config();  // Configuration of defs.h
+
+    bool set(const std::string &name, uint64_t value);  // Sets a parameter by its defs.h name
+    bool load(const std::string &file);                 // Loads a configuration file
+    // Loads --config=<file> and --NAME=value arguments, removing them from argv.
+    // Returns false if a configuration argument is not valid
+    bool parse_args(int &argc, const char **argv);
+    bool parse_args(int &argc, char **argv)             { return parse_args(argc, (const char **) argv); }
+    bool check(std::ostream &err) const;                // Checks that the parameters are consistent
+    void print(std::ostream &os) const;
+
+    // Derived parameters
+    uint words_per_vwr() const  { return vwr_bits / word_bits; }
+    uint mask_per_word() const  { return word_bits / mask_bits; }
+    uint vwr_64b() const        { return (vwr_bits + 64 - 1) / 64; }
+    uint word_64b() const       { return (word_bits + 64 - 1) / 64; }
+    uint mask_64b() const       { return (mask_bits + 64 - 1) / 64; }
+    uint csd_64b() const        { return (csd_bits + 64 - 1) / 64; }
+    uint rf_addr_bits() const   { return LOG2(ib_entries); }
+};
+
+#endif /* SRC_ARCH_CONFIG_H_ */
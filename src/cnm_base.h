@@ -14,21 +14,7 @@
 #include "systemc.h"
 #include "defs.h"
 #include "sc_functions.h"
-
-// RoBaBgRaCoCh mapping
-#define CH_END          GLOBAL_OFFSET
-#define CH_STA          GLOBAL_OFFSET + CHANNEL_BITS - 1
-#define CO_END          GLOBAL_OFFSET + CHANNEL_BITS
-#define CO_STA          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS - 1
-#define RA_END          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS
-#define RA_STA          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS - 1
-#define BG_END          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS
-#define BG_STA          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS - 1
-#define BA_END          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS
-#define BA_STA          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS + BANK_BITS - 1
-#define RO_END          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS + BANK_BITS
-#define RO_STA          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS + BANK_BITS + ROW_BITS - 1
-#define ADDR_TOTAL_BITS GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS + BANK_BITS + ROW_BITS
+#include "packed_bv.h"
 
 #include "opcodes.h"
 #include "microcode/common_format.h"
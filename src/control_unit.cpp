@@ -208,31 +208,42 @@ void control_unit::energy_thread() {
 }
 
 // Write energy stats to file
-void control_unit::write_energy_stats() {    
-    
+void control_unit::write_energy_stats() {
+    write_energy_stats({this}, filename);
+}
+
+// Write energy stats summed over several control units to file
+void control_unit::write_energy_stats(const std::vector<control_unit *> &cus, const std::string &name) {
+    std::ofstream ef_s1, ef_s2, ef_cp;
+    uint64_t count;
+
     // Open file for recording stats for energy model
-    std::string fo = "INPUTS_DIR/recording/" + filename + "_stage1.csv";
+    std::string fo = "INPUTS_DIR/recording/" + name + "_stage1.csv";
     ef_s1.open(fo);
-    fo = "INPUTS_DIR/recording/" + filename + "_stage2.csv";
+    fo = "INPUTS_DIR/recording/" + name + "_stage2.csv";
     ef_s2.open(fo);
-    fo = "INPUTS_DIR/recording/" + filename + "_cp.csv";
+    fo = "INPUTS_DIR/recording/" + name + "_cp.csv";
     ef_cp.open(fo);
     if (!ef_s1.is_open() || !ef_s2.is_open() || !ef_cp.is_open()) {
         std::cerr << "Error opening files for energy recording" << std::endl;
         return;
     }
-    
+
     // Write stage 1 stats
     ef_s1 << "Operation,Size,AddOp,Shift,Count" << std::endl;
     for (uint i = 0; i < uint(EN_OP::MAX); i++) {
         for (uint j = 0; j < uint(SWSIZE::B24)+1; j++) {
             for (uint k = 0; k < uint(ADDOP::MAX); k++) {
                 for (uint l = 0; l < SA_MAX_SHIFT+1; l++) {
+                    count = 0;
+                    for (const control_unit *cu : cus) {
+                        count += cu->stats_s1[i][j][k][l];
+                    }
                     ef_s1 << EN_OP_STRING.at(EN_OP(i)) << ",";
                     ef_s1 << swsize_to_uint(SWSIZE(j)) << ",";
                     ef_s1 << SAOP_STRING.at(ADDOP(k)) << ",";
                     ef_s1 << l << ",";
-                    ef_s1 << stats_s1[i][j][k][l] << std::endl;
+                    ef_s1 << count << std::endl;
                 }
             }
         }
@@ -242,15 +253,23 @@ void control_unit::write_energy_stats() {
     ef_s2 << "Repack,Count" << std::endl;
     uint possibleRepacks = std::extent<decltype(SWREPACK_LIST)>::value;
     for (uint i = 0; i < possibleRepacks; i++) {
+        count = 0;
+        for (const control_unit *cu : cus) {
+            count += cu->stats_s2[uint(SWREPACK_LIST[i])];
+        }
         ef_s2 << REPACK_SEL_STRING.at(SWREPACK_LIST[i]) << ",";
-        ef_s2 << stats_s2[uint(SWREPACK_LIST[i])] << std::endl;
+        ef_s2 << count << std::endl;
     }
 
     // Write CP stats
     ef_cp << "Instruction,Count" << std::endl;
     for (uint i = 0; i < uint(CP_EN_OP::MAX); i++) {
+        count = 0;
+        for (const control_unit *cu : cus) {
+            count += cu->stats_cp[i];
+        }
         ef_cp << CP_EN_OP_STRING.at(CP_EN_OP(i)) << ",";
-        ef_cp << stats_cp[i] << std::endl;
+        ef_cp << count << std::endl;
     }
 
     // Close files
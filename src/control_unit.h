@@ -25,6 +25,7 @@
 #include <iomanip>
 #include <fstream>
 #include <string>
+#include <vector>
 
 // Operation type
 enum class EN_OP : uint {
@@ -214,7 +215,6 @@ public:
 #if EN_MODEL
     // Energy model variables
     std::string filename;
-    std::ofstream ef_s1, ef_s2, ef_cp;
     uint**** stats_s1 = new uint***[uint(EN_OP::MAX)];  // [EN_OP][SWSIZE][ADDOP][SA_SHIFT]
     uint* stats_s2 = new uint[uint(SWREPACK::INV)+1]();
     uint* stats_cp = new uint[uint(CP_EN_OP::MAX)]();
@@ -497,6 +497,8 @@ public:
 #if EN_MODEL
     void energy_thread();
     void write_energy_stats();
+    // Writes the stats summed over several control units (e.g. all the PUs of all pseudo-channels)
+    static void write_energy_stats(const std::vector<control_unit *> &cus, const std::string &name);
 #endif
 };
 
@@ -0,0 +1,78 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Digit masks of a CSD multiplier, for the multiplication sequencer to find
+ * the non-zero digits of its windows without extracting them.
+ *
+ */
+
+#ifndef SRC_CSD_DIGITS_H_
+#define SRC_CSD_DIGITS_H_
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+#include "defs.h"
+#include "opcodes.h"
+#include "packed_bits.h"
+
+#define CSD_DIGITS          (CSD_64B*32)                    // Digits of a CSD RF entry, including the unused bits
+#define CSD_DIGITS_64B      (PACKED_64B(CSD_DIGITS) + 1)    // One more group, read by the windows above the last digit
+
+// One bit per digit of the CSD multiplier, digit i being bits 2i+1..2i
+typedef struct csd_digits {
+    uint64_t nonzero[CSD_DIGITS_64B];   // Digit is +1 or -1
+    uint64_t neg[CSD_DIGITS_64B];       // Digit is -1
+
+    bool operator== (const csd_digits &rhs) const {
+        return !memcmp(nonzero, rhs.nonzero, sizeof(nonzero)) && !memcmp(neg, rhs.neg, sizeof(neg));
+    }
+} csd_digits;
+
+inline std::ostream& operator<< (std::ostream& os, const csd_digits& rhs) {
+    for (int i = CSD_DIGITS_64B - 1; i >= 0; i--) {
+        os << rhs.nonzero[i] << ((i > 0) ? ":" : "/");
+    }
+    for (int i = CSD_DIGITS_64B - 1; i >= 0; i--) {
+        os << rhs.neg[i] << ((i > 0) ? ":" : "");
+    }
+    return os;
+}
+
+// Builds the digit masks of a CSD multiplier. Done once when the CSD operand is
+// written, with a count trailing zeros per non-zero digit
+inline void csd_scan(const uint64_t *csd, csd_digits &d) {
+    memset(&d, 0, sizeof(d));
+    for (uint i = 0; i < CSD_64B; i++) {
+        uint64_t nz = (csd[i] | (csd[i] >> 1)) & 0x5555555555555555ULL;    // LSB of each non-zero digit pair
+        while (nz) {
+            uint b = __builtin_ctzll(nz);
+            uint digit = i*32 + b/2;
+            d.nonzero[digit / 64] |= (uint64_t) 1 << (digit % 64);
+            if (((csd[i] >> b) & 3) != CSD_POSONE) {
+                d.neg[digit / 64] |= (uint64_t) 1 << (digit % 64);
+            }
+            nz &= nz - 1;
+        }
+    }
+}
+
+// Same as looking for the first non-zero digit in fill_csd_window(idx): returns
+// false if the SA_MAX_SHIFT digits of the window are zero, otherwise the offset
+// of the digit in the window and its sign
+inline bool csd_find(const csd_digits &d, uint idx, uint *offset, bool *neg) {
+    if (idx % 2 || idx > CSD_BITS) {
+        idx = 0;    // Default window of fill_csd_window
+    }
+    uint64_t window = packed_get(d.nonzero, idx/2, SA_MAX_SHIFT);
+    if (!window) {
+        return false;
+    }
+    *offset = __builtin_ctzll(window);
+    *neg = packed_get(d.neg, idx/2 + *offset, 1);
+    return true;
+}
+
+#endif /* SRC_CSD_DIGITS_H_ */
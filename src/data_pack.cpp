@@ -7,12 +7,34 @@
  */
 
 #include "data_pack.h"
+#include "swar_ops.h"
 
 void data_pack::comb_method() {
+    uint        i;
+    uint64_t    w1_temp[WORD_64B], w2_temp[WORD_64B];   // Hold inputs
+    uint64_t    out_temp[WORD_64B];     // Holds output while packing
+
+    for (i = 0; i < WORD_64B; i++) {
+        w1_temp[i] = w1[i];
+        w2_temp[i] = w2[i];
+    }
+
+#ifndef __SYNTHESIS__
+    swar_repack(w1_temp, w2_temp, out_temp, in_size, out_size, in_start);
+#else
+    bv_data_pack(w1_temp, w2_temp, out_temp, in_size, out_size, in_start);
+#endif
+
+    // Write to output
+    for (i = 0; i < WORD_64B; i++)
+        output[i]->write(out_temp[i]);
+}
+
+// Data packing with SystemC bit-vectors, subword by subword (reference for swar_repack)
+void data_pack::bv_data_pack(const uint64_t *w1, const uint64_t *w2, uint64_t *out_temp, uint in_size, uint out_size, uint in_start) {
     uint        i;
     uint        in_idx;                 // Holds current input subword index
     bool        nw1_w2;                 // Selects if current subword index is in w1 (false) or in w2 (true)
-    uint64_t    out_temp[WORD_64B];     // Holds output while packing
     sc_bv<WORD_64B*64>  w1_aux, w2_aux; // Hold casted w1 and w2
     sc_bv<WORD_64B*64>  out_aux('0');   // Holds casted output
     sc_bit              sign;           // Holds sign for sign extension
@@ -111,8 +133,4 @@ void data_pack::comb_method() {
             out_temp[i] = parse_aux.to_uint64();
         }
     }
-
-    // Write to output
-    for (i = 0; i < WORD_64B; i++)
-        output[i]->write(out_temp[i]);
 }
@@ -33,6 +33,7 @@ public:
     }
 
     void comb_method();   // Performs data packing according to the flags
+    void bv_data_pack(const uint64_t *w1, const uint64_t *w2, uint64_t *out_temp, uint in_size, uint out_size, uint in_start);
 
 #ifdef __SYNTHESIS__
     void circular_shift_right(sc_bv<2*WORD_BITS> &w1_w2, uint n_bits);
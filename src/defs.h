@@ -18,6 +18,11 @@
 #define EN_MODEL    0   // 1 if generating a report for the energy model
 #define VCD_TRACE   1   // 1 if generating VCD traces
 #define DEBUG       0   // 1 if using assert library and other debug features
+#define PACKED_VWR  0   // 1 if using the VWR model backed by 64-bit words (faster, no VWR waveforms)
+#define FAST_BUSES  0   // 1 if using two-valued point-to-point buses instead of resolved tristate nets (needs PACKED_VWR)
+#define ENGINE_CHECK 0  // 1 if cross-checking the pch testbench against the standalone SoftSIMD engine
+#define BANK_MODEL  0   // 1 if the pch testbench keeps the bank contents, so RDs without payload read what was preloaded or written
+#define CYCLE_SIM   0   // 1 if the PUs of a pch are evaluated once per cycle by the standalone engine instead of the SystemC modules (no PU waveforms)
 
 #define CLK_PERIOD 3333
 #define RESOLUTION SC_PS
@@ -84,9 +89,43 @@
 #define COL_BITS        5
 #define GLOBAL_OFFSET   6
 
+// RoBaBgRaCoCh mapping
+#define CH_END          GLOBAL_OFFSET
+#define CH_STA          GLOBAL_OFFSET + CHANNEL_BITS - 1
+#define CO_END          GLOBAL_OFFSET + CHANNEL_BITS
+#define CO_STA          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS - 1
+#define RA_END          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS
+#define RA_STA          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS - 1
+#define BG_END          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS
+#define BG_STA          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS - 1
+#define BA_END          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS
+#define BA_STA          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS + BANK_BITS - 1
+#define RO_END          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS + BANK_BITS
+#define RO_STA          GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS + BANK_BITS + ROW_BITS - 1
+#define ADDR_TOTAL_BITS GLOBAL_OFFSET + CHANNEL_BITS + COL_BITS + RANK_BITS + BG_BITS + BANK_BITS + ROW_BITS
+
 #define RF_ADDR_BITS    (LOG2(IB_ENTRIES))  // Combined column and row address bits to address RFs
 #define RF_SEL_BITS     (ROW_BITS-1+COL_BITS-RF_ADDR_BITS)  // Number of bits to select the RF
 
+// Fast simulation modes only cover the default interfaces
+#if FAST_BUSES && (!PACKED_VWR || MIXED_SIM || RECORDING || DUAL_BANK_INTERFACE || VWR_DRAM_CLK > 1)
+#error "FAST_BUSES needs PACKED_VWR and a single-cycle, single-bank DRAM interface without MIXED_SIM or RECORDING"
+#endif
+
+// The standalone engine covers the same interfaces, with HW loops
+#define ENGINE_SUPPORTED    (!DUAL_BANK_INTERFACE && VWR_DRAM_CLK == 1 && HW_LOOP)
+#if ENGINE_CHECK && (!ENGINE_SUPPORTED || MIXED_SIM)
+#error "ENGINE_CHECK needs a single-cycle, single-bank DRAM interface with HW_LOOP and without MIXED_SIM"
+#endif
+#if CYCLE_SIM && (!ENGINE_SUPPORTED || MIXED_SIM || RECORDING || EN_MODEL || ENGINE_CHECK)
+#error "CYCLE_SIM needs a single-cycle, single-bank DRAM interface with HW_LOOP and without MIXED_SIM, RECORDING, EN_MODEL or ENGINE_CHECK"
+#endif
+
+// The bank contents are only kept by the SystemC testbench
+#if BANK_MODEL && MIXED_SIM
+#error "BANK_MODEL needs a SystemC-only simulation"
+#endif
+
 // Define to use or not assert library
 #if DEBUG == 0
 #define NDEBUG
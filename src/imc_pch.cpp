@@ -7,3 +7,94 @@
  */
 
 #include "imc_pch.h"
+
+#if !defined(__SYNTHESIS__) && CYCLE_SIM
+
+void imc_pch::cycle_thread() {
+    uint i;
+    engine_cmd cmd;
+    bool out_en, busy;
+    bool driven = false;                        // PUs drove the buses in the previous evaluation
+    sc_time period(CLK_PERIOD, RESOLUTION);
+#if FAST_BUSES
+    packed_bv<DRAM_BITS> bus_aux, zeros;        // Two-valued buses are zero when not driven
+#else
+    sc_lv<DRAM_BITS> bus_aux(SC_LOGIC_0);
+    sc_lv<DRAM_BITS> allzs(SC_LOGIC_Z);
+#endif
+
+    // Reset behaviour
+    for (i = 0; i < CORES_PER_PCH; i++) {
+        engine->pu[i].reset();
+#if FAST_BUSES
+        dram_out[i]->write(zeros);
+#else
+        dram_buses[i]->write(allzs);
+#endif
+    }
+    engine->cur_cycle = (uint64_t) (sc_time_stamp() / period) + 1;
+    engine->bank_pending = false;
+
+    wait();
+
+    // Clocked behaviour, one evaluation of the PUs per cycle
+    while (1) {
+        // Cycles without commands where no PU was busy are only counted
+        engine->idle_until((uint64_t) (sc_time_stamp() / period));
+
+        // Bank data driven in the cycle after a RD
+        if (engine->bank_pending) {
+            for (i = 0; i < CORES_PER_PCH; i++) {
+#if FAST_BUSES
+                memcpy(engine->bank_data[i], dram_in[i]->read().w, sizeof(engine->bank_data[i]));
+#else
+                lv_to_packed(dram_buses[i]->read(), engine->bank_data[i], VWR_BITS);
+#endif
+            }
+        }
+
+        cmd.RD = RD->read();
+        cmd.WR = WR->read();
+        cmd.row_addr = row_addr->read();
+        cmd.col_addr = col_addr->read();
+        cmd.DQ = DQ->read();
+        out_en = engine->step(cmd, engine_out);
+        engine->bank_pending = cmd.RD;
+
+        if (out_en) {
+            for (i = 0; i < CORES_PER_PCH; i++) {
+#if FAST_BUSES
+                memcpy(bus_aux.w, engine_out[i], sizeof(engine_out[i]));
+                dram_out[i]->write(bus_aux);
+#else
+                packed_to_lv(engine_out[i], bus_aux, VWR_BITS);
+                dram_buses[i]->write(bus_aux);
+#endif
+            }
+            driven = true;
+        } else if (driven) {
+            for (i = 0; i < CORES_PER_PCH; i++) {
+#if FAST_BUSES
+                dram_out[i]->write(zeros);
+#else
+                dram_buses[i]->write(allzs);
+#endif
+            }
+            driven = false;
+        }
+
+        // Without a command in this cycle, the next one raises RD or WR. Until
+        // then, idle PUs are not evaluated
+        busy = engine->bank_pending;
+        for (i = 0; i < CORES_PER_PCH; i++) {
+            busy |= engine->pu[i].busy();
+        }
+        if (!cmd.RD && !cmd.WR && !busy && !driven) {
+            wait(RD->posedge_event() | WR->posedge_event());
+        }
+
+        wait();
+    }
+}
+
+#endif
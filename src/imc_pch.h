@@ -11,6 +11,9 @@
 
 #include "cnm_base.h"
 #include "softsimd_pu.h"
+#if CYCLE_SIM
+#include "softsimd_engine.h"
+#endif
 
 class imc_pch: public sc_module {
 public:
@@ -96,6 +99,9 @@ public:
 #if DUAL_BANK_INTERFACE
     sc_inout_rv<DRAM_BITS>      even_buses[CORES_PER_PCH];  // Direct data in/out to the even banks
     sc_inout_rv<DRAM_BITS>      odd_buses[CORES_PER_PCH];   // Direct data in/out to the odd banks
+#elif FAST_BUSES
+    sc_in<packed_bv<DRAM_BITS> >    dram_in[CORES_PER_PCH];     // Direct data in from the DRAM
+    sc_out<packed_bv<DRAM_BITS> >   dram_out[CORES_PER_PCH];    // Direct data out to the DRAM
 #else
     sc_inout_rv<DRAM_BITS>      dram_buses[CORES_PER_PCH];  // Direct data in/out to the DRAM
 #endif
@@ -105,7 +111,12 @@ public:
     // Auxiliar signals
 
     // Internal modules
+#if CYCLE_SIM
+    softsimd_engine_pch *engine;            // PUs evaluated once per cycle
+    uint64_t (*engine_out)[VWR_64B];        // Words driven by each PU
+#else
     softsimd_pu *imc_cores[CORES_PER_PCH];   // Vector of IMC cores
+#endif
 
     SC_HAS_PROCESS(imc_pch);
 #if (RECORDING || EN_MODEL)
@@ -115,6 +126,14 @@ public:
     imc_pch(sc_module_name name) : sc_module(name) {
 #endif
 
+#if CYCLE_SIM
+        engine = new softsimd_engine_pch;
+        engine_out = new uint64_t[CORES_PER_PCH][VWR_64B];
+
+        SC_THREAD(cycle_thread);
+        sensitive << clk.neg();
+        async_reset_signal_is(rst, false);
+#else
         uint i;
 
         for (i = 0; i < CORES_PER_PCH; i++) {
@@ -138,13 +157,23 @@ public:
 #if (DUAL_BANK_INTERFACE)
             imc_cores[i]->even_bus(even_buses[i]);
             imc_cores[i]->odd_bus(odd_buses[i]);
+#elif FAST_BUSES
+            imc_cores[i]->dram_in(dram_in[i]);
+            imc_cores[i]->dram_out(dram_out[i]);
 #else
             imc_cores[i]->dram_bus(dram_buses[i]);
 #endif
         }
+#endif
 
     }
 
+#if CYCLE_SIM
+    // Evaluates all the PUs in the falling edge, with the command and bank data
+    // driven after the rising one
+    void cycle_thread();
+#endif
+
 #endif
 
 };
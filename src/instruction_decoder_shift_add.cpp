@@ -62,6 +62,9 @@ void instruction_decoder_shift_add::comb_method() {
             case OPC_STORAGE::VWR:
                 sa_op1_from->write(MUX::VWR);
             break;
+            case OPC_STORAGE::ZERO:     // Zero multiplier
+                sa_op1_from->write(MUX::ZERO);
+            break;
             default:
             break;
         }
@@ -8,6 +8,44 @@
 
 #include "mask_unit.h"
 
+#ifndef __SYNTHESIS__
+
+void mask_unit::comb_method() {
+    uint i;
+    uint64_t        mask_raw[MASK_64B]; // Mask before replication
+    const uint64_t  *mask;              // Replicated mask in 64-bit uint
+    uint64_t        out_temp = 0;
+
+    // The mask is only replicated the first time its value is read
+    for (i = 0; i < MASK_64B; i++) {
+        mask_raw[i] = mask_in[i]->read();
+    }
+    mask = mask_rep.get(mask_raw);
+
+    for (i = 0; i < WORD_64B; i++) {
+        switch (op_sel->read()) {
+            case MASKOP::NOP:
+                out_temp = word_in[i]->read();
+            break;
+            case MASKOP::AND:
+                out_temp = word_in[i]->read() & mask[i];
+            break;
+            case MASKOP::OR:
+                out_temp = word_in[i]->read() | mask[i];
+            break;
+            case MASKOP::XOR:
+                out_temp = word_in[i]->read() ^ mask[i];
+            break;
+            default:
+                out_temp = word_in[i]->read();
+            break;
+        }
+        output[i]->write(out_temp);
+    }
+}
+
+#else   // __SYNTHESIS__
+
 void mask_unit::comb_method() {
     uint i;
     sc_bv<MASK_64B*64>  mask_aux;       // Holds parsed mask
@@ -56,3 +94,5 @@ void mask_unit::comb_method() {
         output[i]->write(out_temp);
     }
 }
+
+#endif  // __SYNTHESIS__
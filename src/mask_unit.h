@@ -12,6 +12,7 @@
 #include "systemc.h"
 
 #include "cnm_base.h"
+#include "swar_ops.h"
 
 class mask_unit: public sc_module {
 public:
@@ -21,6 +22,9 @@ public:
     sc_out<uint64_t>    output[WORD_64B];     // Masked output
 
     // Internal signals and variables
+#ifndef __SYNTHESIS__
+    swar_rep_cache<MASK_ENTRIES> mask_rep;    // Replicated MRF masks, memoized by value
+#endif
 
     SC_CTOR(mask_unit) {
         uint i;
@@ -18,6 +18,31 @@ void sc_trace (sc_trace_file*& tf, const MS_FSM& store, std::string nm) {
     sc_trace(tf, uint(store), nm);
 }
 
+#ifndef __SYNTHESIS__
+
+void sc_trace (sc_trace_file*& tf, const csd_digits& digits, std::string nm) {
+    for (uint i = 0; i < CSD_DIGITS_64B; i++) {
+        sc_trace(tf, digits.nonzero[i], nm + "_nonzero_" + std::to_string(i));
+        sc_trace(tf, digits.neg[i], nm + "_neg_" + std::to_string(i));
+    }
+}
+
+// The non-zero digits are found once, when the multiplicand is registered
+void mult_sequencer::load_csd(ms_csd_t &csd) {
+    uint64_t csd_aux[CSD_64B];
+
+    for (uint i = 0; i < CSD_64B; i++) {
+        csd_aux[i] = csd_in[i]->read();
+    }
+    csd_scan(csd_aux, csd);
+}
+
+bool mult_sequencer::find_nonzero(const ms_csd_t &csd, uint idx, uint *offset, bool *neg) {
+    return csd_find(csd, idx, offset, neg);
+}
+
+#else   // __SYNTHESIS__
+
 sc_bv<SA_MAX_SHIFT*2> fill_csd_window (uint idx, sc_bv<CSD_64B*64+2*SA_MAX_SHIFT> csd) {
     sc_bv<SA_MAX_SHIFT*2> window = 0;
     switch (idx) {
@@ -51,6 +76,31 @@ sc_bv<SA_MAX_SHIFT*2> fill_csd_window (uint idx, sc_bv<CSD_64B*64+2*SA_MAX_SHIFT
     return window;
 }
 
+void mult_sequencer::load_csd(ms_csd_t &csd) {
+    sc_bv<64> parse_aux;
+
+    csd = 0;
+    for (uint i = 0; i < CSD_64B; i++) {
+        parse_aux = csd_in[i]->read();
+        csd.range((i+1)*64-1, i*64) = parse_aux;
+    }
+}
+
+bool mult_sequencer::find_nonzero(const ms_csd_t &csd, uint idx, uint *offset, bool *neg) {
+    sc_bv<SA_MAX_SHIFT*2> window = fill_csd_window(idx, csd);
+
+    for (uint i = 0; i < SA_MAX_SHIFT*2; i += 2) {
+        if (window.range(i+1,i) != CSD_ZERO) {  // Non zero bit
+            *offset = i/2;
+            *neg = (window.range(i+1,i) != CSD_POSONE);
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif  // __SYNTHESIS__
+
 void mult_sequencer::clk_thread() {
     // Reset
     state_reg = MS_FSM::IDLE;
@@ -60,7 +110,7 @@ void mult_sequencer::clk_thread() {
     src_n_reg = 0;
     dst_reg = OPC_STORAGE::R3;
     dst_n_reg = 0;
-    csd_reg = 0;
+    csd_reg = ms_csd_t();
     len_reg = CSD_BITS / 2;
 
     wait();
@@ -146,10 +196,9 @@ void mult_sequencer::fsm_method() {
 }
 
 void mult_sequencer::comb_method() {
-    uint i;
-    sc_bv<64> parse_aux;
-    sc_bv<CSD_64B*64+2*SA_MAX_SHIFT> csd_aux;
-    sc_bv<SA_MAX_SHIFT*2> window;
+    uint offset;
+    bool neg;
+    ms_csd_t csd_aux;
 
     // Default signals for registers
     idx_nxt = idx_reg;
@@ -196,90 +245,74 @@ void mult_sequencer::comb_method() {
                 src_n_nxt = src_n->read();
                 dst_nxt = dst->read();
                 dst_n_nxt = dst_n->read();
-                csd_aux = 0;
-                for (uint i = 0; i < CSD_64B; i++) {
-                    parse_aux = csd_in[i]->read();
-                    csd_aux.range((i+1)*64-1, i*64) = parse_aux;
-                }
+                load_csd(csd_aux);
                 csd_nxt = csd_aux;
 #if !STATIC_CSD_LEN
                 len_nxt = csd_len->read();
 #endif
 
-                // If starting new multiplication, observe the first bits directly from csd_in
-                window = fill_csd_window(0, csd_aux);
-
                 // Update index for next window in case non-zero bits are not found
                 idx_nxt = idx_reg + SA_MAX_SHIFT*2;
 
-                // Find first non-zero bit
-                for (i = 0; i < SA_MAX_SHIFT*2; i += 2) {
-                    if (window.range(i+1,i) != CSD_ZERO) {  // Non zero bit
-                        mov_valid->write(true);
-                        mov_src->write(src->read());
-                        mov_src_n->write(src_n->read());
-                        if (window.range(i+1,i) == CSD_POSONE) {    // +1
+                // If starting new multiplication, find the first non-zero bit directly from csd_in
+                if (find_nonzero(csd_aux, 0, &offset, &neg)) {
+                    mov_valid->write(true);
+                    mov_src->write(src->read());
+                    mov_src_n->write(src_n->read());
+                    if (!neg) {     // +1
 #if (INSTR_FORMAT == BASE_FORMAT)
-                            sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::NOP)]));
-                            sa_shift->write(0);
+                        sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::NOP)]));
+                        sa_shift->write(0);
 #elif (INSTR_FORMAT == ENCODED_SHIFT_FORMAT)
-                            sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::NOP)][0]));
+                        sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::NOP)][0]));
 #endif
-                        } else {                                    // -1
+                    } else {        // -1
 #if (INSTR_FORMAT == BASE_FORMAT)
-                            sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::INV)]));
-                            sa_shift->write(0);
+                        sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::INV)]));
+                        sa_shift->write(0);
 #elif (INSTR_FORMAT == ENCODED_SHIFT_FORMAT)
-                            sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::INV)][0]));
+                        sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::INV)][0]));
 #endif
-                        }
-                        sa_valid->write(true);
-                        sa_size->write(sw_size->read());
-                        sa_src0->write(OPC_STORAGE::VWR);
-                        sa_dst->write(OPC_STORAGE::R3);
-                        first_found = true;
-                        idx_nxt = idx_reg + i + 2;  // Update index for next window
-                        break;
                     }
+                    sa_valid->write(true);
+                    sa_size->write(sw_size->read());
+                    sa_src0->write(OPC_STORAGE::VWR);
+                    sa_dst->write(OPC_STORAGE::R3);
+                    first_found = true;
+                    idx_nxt = idx_reg + 2*offset + 2;   // Update index for next window
                 }
             }
         break;
         case MS_FSM::FIND_NONZERO:  // Searching for first non-zero bit in CSD multiplier
-            // Observe next bits
-            csd_aux = csd_reg;
-            window = fill_csd_window(idx_reg, csd_aux);
-
             // Update index for next window in case non-zero bits are not found
             idx_nxt = idx_reg + SA_MAX_SHIFT*2;
 
-            // Find first non-zero bit
-            for (i = 0; i < SA_MAX_SHIFT*2; i += 2) {
-                if (window.range(i+1,i) != CSD_ZERO) {  // Non zero bit
-                    mov_valid->write(true);
-                    mov_src->write(src_reg);
-                    mov_src_n->write(src_n_reg);
-                    if (window.range(i+1,i) == CSD_POSONE) {    // +1
+            // Find first non-zero bit in the next bits
+            csd_aux = csd_reg;
+            if (find_nonzero(csd_aux, idx_reg, &offset, &neg)) {
+                mov_valid->write(true);
+                mov_src->write(src_reg);
+                mov_src_n->write(src_n_reg);
+                if (!neg) {     // +1
 #if (INSTR_FORMAT == BASE_FORMAT)
-                            sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::NOP)]));
-                            sa_shift->write(0);
+                    sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::NOP)]));
+                    sa_shift->write(0);
 #elif (INSTR_FORMAT == ENCODED_SHIFT_FORMAT)
-                            sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::NOP)][0]));
+                    sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::NOP)][0]));
 #endif
-                    } else {                                    // -1
+                } else {        // -1
 #if (INSTR_FORMAT == BASE_FORMAT)
-                            sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::INV)]));
-                            sa_shift->write(0);
+                    sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::INV)]));
+                    sa_shift->write(0);
 #elif (INSTR_FORMAT == ENCODED_SHIFT_FORMAT)
-                            sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::INV)][0]));
+                    sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::INV)][0]));
 #endif
-                    }
-                    sa_valid->write(true);
-                    sa_src0->write(OPC_STORAGE::VWR);
-                    sa_dst->write(OPC_STORAGE::R3);
-                    first_found = true;
-                    idx_nxt = idx_reg + i + 2;  // Update index for next window
-                    break;
                 }
+                sa_valid->write(true);
+                sa_src0->write(OPC_STORAGE::VWR);
+                sa_dst->write(OPC_STORAGE::R3);
+                first_found = true;
+                idx_nxt = idx_reg + 2*offset + 2;   // Update index for next window
             }
         break;
         case MS_FSM::ZERO_MULT:     // All bits are zero in CSD multiplier
@@ -294,10 +327,6 @@ void mult_sequencer::comb_method() {
             sa_dst->write(OPC_STORAGE::R3);
         break;
         case MS_FSM::GEN_SA:        // Generating sequence of shifts and add after first non-zero bit
-            // Observe next bits
-            csd_aux = csd_reg;
-            window = fill_csd_window(idx_reg, csd_aux);
-
             // Update index for next window in case non-zero bits are not found
             idx_nxt = idx_reg + SA_MAX_SHIFT*2;
 
@@ -313,26 +342,24 @@ void mult_sequencer::comb_method() {
             sa_dst->write(OPC_STORAGE::R3);
 
             // Find next non-zero bit
-            for (i = 0; i < SA_MAX_SHIFT*2; i += 2) {
-                if (window.range(i+1,i) != CSD_ZERO) {  // Non zero bit
-                    if (window.range(i+1,i) == CSD_POSONE) {    // +1
+            csd_aux = csd_reg;
+            if (find_nonzero(csd_aux, idx_reg, &offset, &neg)) {
+                if (!neg) {     // +1
 #if (INSTR_FORMAT == BASE_FORMAT)
-                        sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::ADD)]));
-                        sa_shift->write(i/2 + 1);
+                    sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::ADD)]));
+                    sa_shift->write(offset + 1);
 #elif (INSTR_FORMAT == ENCODED_SHIFT_FORMAT)
-                        sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::ADD)][i/2 + 1]));
+                    sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::ADD)][offset + 1]));
 #endif
-                    } else {                                    // -1
+                } else {        // -1
 #if (INSTR_FORMAT == BASE_FORMAT)
-                        sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::SUB)]));
-                        sa_shift->write(i/2 + 1);
+                    sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::SUB)]));
+                    sa_shift->write(offset + 1);
 #elif (INSTR_FORMAT == ENCODED_SHIFT_FORMAT)
-                        sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::SUB)][i/2 + 1]));
+                    sa_index->write(uint(mult_seq_microinstr[uint(ADDOP::SUB)][offset + 1]));
 #endif
-                    }
-                    idx_nxt = idx_reg + i + 2;  // Update index for next window
-                    break;
                 }
+                idx_nxt = idx_reg + 2*offset + 2;   // Update index for next window
             }
         break;
         case MS_FSM::WRITE_NOR3:    // Write multiplication result to R1 and/or R2
@@ -13,6 +13,7 @@
 #include "systemc.h"
 
 #include "cnm_base.h"
+#include "csd_digits.h"
 
 enum class MS_FSM : uint {IDLE, FIND_NONZERO, ZERO_MULT, GEN_SA, WRITE_NOR3};
 
@@ -20,7 +21,15 @@ ostream& operator<< (ostream& os, const MS_FSM& rhs);
 
 void sc_trace (sc_trace_file*& tf, const MS_FSM& store, std::string nm);
 
+#ifndef __SYNTHESIS__
+typedef csd_digits                          ms_csd_t;   // Non-zero digits of the CSD multiplicand
+
+void sc_trace (sc_trace_file*& tf, const csd_digits& digits, std::string nm);
+#else
+typedef sc_bv<CSD_64B*64+2*SA_MAX_SHIFT>    ms_csd_t;   // CSD multiplicand, padded for the last windows
+
 sc_bv<SA_MAX_SHIFT*2> fill_csd_window (uint idx, sc_bv<CSD_64B*64+2*SA_MAX_SHIFT> csd);
+#endif
 
 class mult_sequencer: public sc_module {
 public:
@@ -61,7 +70,7 @@ public:
     sc_signal<uint>                                 src_n_nxt, src_n_reg;   // SRC index passed by macroinstruction
     sc_signal<OPC_STORAGE>                          dst_nxt, dst_reg;       // DST passed by macroinstruction
     sc_signal<uint>                                 dst_n_nxt, dst_n_reg;   // DST index passed by macroinstruction
-    sc_signal<sc_bv<CSD_64B*64+2*SA_MAX_SHIFT> >    csd_nxt, csd_reg;       // CSD multiplicand
+    sc_signal<ms_csd_t>                             csd_nxt, csd_reg;       // CSD multiplicand
     sc_signal<uint8_t>                              len_nxt, len_reg;       // CSD multiplicand length
     sc_signal<uint>                                 state_out;
 
@@ -90,6 +99,8 @@ public:
     void clk_thread();  // Manages registers
     void fsm_method();  // FSM governing the behavior of the multiplication sequencer
     void comb_method(); // Logic to generate the microinstruction sequence for multiplication
+    void load_csd(ms_csd_t &csd);   // Reads the CSD multiplicand input
+    bool find_nonzero(const ms_csd_t &csd, uint idx, uint *offset, bool *neg);  // First non-zero digit in the window at idx
 };
 
 #endif /* SRC_MULT_SEQUENCER_H_ */
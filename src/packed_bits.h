@@ -0,0 +1,99 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Helpers for handling wide values packed in arrays of 64-bit words,
+ * bit 0 being the LSB of element 0.
+ *
+ */
+
+#ifndef SRC_PACKED_BITS_H_
+#define SRC_PACKED_BITS_H_
+
+#include <cstdint>
+#include <cstring>
+
+#define PACKED_64B(bits)    (((bits) + 64 - 1) / 64)    // 64-bit groups needed to represent bits
+
+// Mask with the n LSBs set (n <= 64)
+inline uint64_t packed_lsb_mask(unsigned int n) {
+    return (n >= 64) ? ~(uint64_t) 0 : (((uint64_t) 1 << n) - 1);
+}
+
+// Reads n <= 64 bits starting at bit lo
+inline uint64_t packed_get(const uint64_t *src, unsigned int lo, unsigned int n) {
+    unsigned int w = lo / 64, b = lo % 64;
+    uint64_t val = src[w] >> b;
+    if (b + n > 64) {
+        val |= src[w + 1] << (64 - b);
+    }
+    return val & packed_lsb_mask(n);
+}
+
+// Writes n <= 64 bits starting at bit lo, leaving the rest untouched
+inline void packed_set(uint64_t *dst, unsigned int lo, unsigned int n, uint64_t val) {
+    unsigned int w = lo / 64, b = lo % 64;
+    uint64_t mask = packed_lsb_mask(n);
+    val &= mask;
+    dst[w] = (dst[w] & ~(mask << b)) | (val << b);
+    if (b + n > 64) {
+        unsigned int rem = b + n - 64;
+        dst[w + 1] = (dst[w + 1] & ~packed_lsb_mask(rem)) | (val >> (64 - b));
+    }
+}
+
+// Copies len bits from src (starting at src_lo) to dst (starting at dst_lo)
+inline void packed_copy(uint64_t *dst, unsigned int dst_lo, const uint64_t *src, unsigned int src_lo, unsigned int len) {
+    if (!(dst_lo % 64) && !(src_lo % 64) && !(len % 64)) {  // Word-aligned, most common case
+        memmove(dst + dst_lo / 64, src + src_lo / 64, len / 8);
+        return;
+    }
+    while (len) {
+        unsigned int chunk = 64 - dst_lo % 64;
+        if (chunk > len) {
+            chunk = len;
+        }
+        packed_set(dst, dst_lo, chunk, packed_get(src, src_lo, chunk));
+        dst_lo += chunk;
+        src_lo += chunk;
+        len -= chunk;
+    }
+}
+
+// Clears all bits from bit lo up to (not including) bit hi
+inline void packed_clear(uint64_t *dst, unsigned int lo, unsigned int hi) {
+    while (lo < hi) {
+        unsigned int chunk = 64 - lo % 64;
+        if (chunk > hi - lo) {
+            chunk = hi - lo;
+        }
+        packed_set(dst, lo, chunk, 0);
+        lo += chunk;
+    }
+}
+
+// Converts a SystemC bit/logic vector into packed words. Bits with Z/X values
+// take their data bit, as sc_lv::to_uint64() does (Z -> 0, X -> 1)
+template<class LV>
+inline void lv_to_packed(const LV &lv, uint64_t *dst, unsigned int width) {
+    for (unsigned int i = 0; i < PACKED_64B(width); i++) {
+        uint64_t lo = lv.get_word(2*i);
+        uint64_t hi = (64*i + 32 < width) ? (uint64_t) lv.get_word(2*i + 1) : 0;
+        dst[i] = lo | (hi << 32);
+    }
+    if (width % 64) {
+        dst[PACKED_64B(width) - 1] &= packed_lsb_mask(width % 64);
+    }
+}
+
+// Converts packed words into a SystemC bit/logic vector with only 0/1 values
+template<class LV>
+inline void packed_to_lv(const uint64_t *src, LV &lv, unsigned int width) {
+    for (unsigned int i = 0; i < (width + 32 - 1) / 32; i++) {
+        lv.set_word(i, (uint32_t) (src[i / 2] >> (32 * (i % 2))));
+        lv.set_cword(i, 0);
+    }
+    lv.clean_tail();
+}
+
+#endif /* SRC_PACKED_BITS_H_ */
@@ -0,0 +1,68 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Two-valued bit-vector packed in 64-bit words, to be carried by plain
+ * sc_signal channels in the fast simulation modes.
+ *
+ */
+
+#ifndef SRC_PACKED_BV_H_
+#define SRC_PACKED_BV_H_
+
+#include "systemc.h"
+
+#include <cstring>
+#include <iomanip>
+#include <string>
+
+#include "packed_bits.h"
+
+template<uint width>
+struct packed_bv {
+    uint64_t w[PACKED_64B(width)];  // Contents, w[0] holds the LSBs
+
+    packed_bv() {
+        clear();
+    }
+
+    void clear() {
+        memset(w, 0, sizeof(w));
+    }
+
+    uint64_t &operator[](uint i) {
+        return w[i];
+    }
+
+    const uint64_t &operator[](uint i) const {
+        return w[i];
+    }
+
+    bool operator==(const packed_bv &other) const {
+        return !memcmp(w, other.w, sizeof(w));
+    }
+};
+
+// Prints the vector in hexadecimal, MSBs first
+template<uint width>
+inline std::ostream &operator<<(std::ostream &os, const packed_bv<width> &bv) {
+    std::ios_base::fmtflags flags = os.flags();
+    char fill = os.fill('0');
+    os << "0x" << std::hex;
+    for (int i = PACKED_64B(width) - 1; i >= 0; i--) {
+        os << std::setw(16) << bv[i];
+    }
+    os.fill(fill);
+    os.flags(flags);
+    return os;
+}
+
+// Traces the vector as one 64-bit value per word
+template<uint width>
+inline void sc_trace(sc_trace_file *tf, const packed_bv<width> &bv, const std::string &name) {
+    for (uint i = 0; i < PACKED_64B(width); i++) {
+        sc_trace(tf, bv[i], name + "_" + std::to_string(i));
+    }
+}
+
+#endif /* SRC_PACKED_BV_H_ */
@@ -22,6 +22,74 @@ public:
     sc_in<uint> wr_addr;	// Index the address to be written
     sc_in<T>    wr_port;    // Write port
 
+#ifndef __SYNTHESIS__
+
+    //Internal signals and variables
+    T           reg[size];      // Register file contents
+    T           wr_data;        // Write pending to be committed
+    uint        wr_idx;         // Index of the pending write
+    sc_event    commit_ev;      // Commits the pending write, one delta after the clock edge
+    sc_event    rd_ev;          // Updates the read port after a write to the read index
+
+    SC_CTOR(rf_twoport) {
+        SC_METHOD(read_method);
+        sensitive << rd_addr << rd_ev;
+
+        SC_METHOD(commit_method);
+        sensitive << commit_ev;
+        dont_initialize();
+
+        SC_THREAD(write_update_thread);
+        sensitive << clk.pos();
+        async_reset_signal_is(rst, false);
+
+        for (uint i = 0; i < size; i++)
+            reg[i] = (T) 0;
+        wr_idx = 0;
+
+    }
+
+    // Shows the indexed contents for reading
+    void read_method() {
+        if (rd_addr->read() < size)
+            rd_port->write(reg[rd_addr->read()]);
+        else
+            rd_port->write((T) 0);
+    }
+
+    // Writes the pending entry, as a signal would in the update phase. Only a
+    // write to the read index updates the read port
+    void commit_method() {
+        reg[wr_idx] = wr_data;
+        if (wr_idx == rd_addr->read())
+            rd_ev.notify();
+    }
+
+    // Write to the RF
+    void write_update_thread() {
+        // Reset behaviour
+        commit_ev.cancel();
+        for (uint i = 0; i < size; i++) {
+            reg[i] = (T) 0;
+        }
+        rd_ev.notify(SC_ZERO_TIME);
+
+        wait();
+
+        // Clocked behaviour
+        while (1) {
+            if (wr_en->read() && wr_addr->read() < size) {
+                wr_idx = wr_addr->read();
+                wr_data = wr_port->read();
+                commit_ev.notify(SC_ZERO_TIME);
+            }
+
+            wait();
+        }
+    }
+
+#else   // __SYNTHESIS__
+
     //Internal signals and variables
     sc_signal<T> reg[size];		// Register file contents
 
@@ -66,6 +134,8 @@ public:
             wait();
         }
     }
+
+#endif  // __SYNTHESIS__
 };
 
 #endif /* RF_TWOPORT_H_ */
@@ -12,6 +12,7 @@
 #include "systemc.h"
 
 #include "cnm_base.h"
+#include "swar_ops.h"
 
 template<uint max_shift>
 class right_shifter: public sc_module {
@@ -34,8 +35,29 @@ public:
     // Shift input if below maximum shift
     void comb_method() {
 
-        uint i, j;
+        uint i;
+        uint64_t            in_temp[WORD_64B];  // Holds input
         uint64_t            out_temp[WORD_64B]; // Holds output while shifting
+
+        for (i = 0; i < WORD_64B; i++)
+            in_temp[i] = input[i];
+
+#ifndef __SYNTHESIS__
+        swar_right_shift(in_temp, out_temp, shift, size, max_shift);
+#else
+        bv_right_shift(in_temp, out_temp, shift, size);
+#endif
+
+        // Write to output
+        for (i = 0; i < WORD_64B; i++) {
+            output[i]->write(out_temp[i]);
+        }
+    }
+
+    // Shift with SystemC bit-vectors, bit by bit (reference for swar_right_shift)
+    static void bv_right_shift(const uint64_t *input, uint64_t *out_temp, uint shift, uint size) {
+
+        uint i, j;
         sc_bv<64>           parse_aux;          // Used for parsing
         sc_bv<WORD_64B*64>  in_aux;             // Holds casted input
         sc_bv<WORD_64B*64>  out_aux('0');       // Holds casted output
@@ -70,7 +92,7 @@ public:
                         }
                 }
 #else   // __SYNTHESIS__
-                guard_keep_sign_extend(in_aux, out_aux, size->read(), shift->read());
+                guard_keep_sign_extend(in_aux, out_aux, size, shift);
 #endif  // __SYNTHESIS__
             }
 
@@ -80,17 +102,12 @@ public:
                 out_temp[i] = parse_aux.to_uint64();
             }
         }
-
-        // Write to output
-        for (i = 0; i < WORD_64B; i++) {
-            output[i]->write(out_temp[i]);
-        }
     }
 
 #ifdef __SYNTHESIS__
 
     template <uint size>
-    void sign_extend(sc_bv<WORD_64B*64> input, sc_bv<WORD_64B*64> &output, uint shift, uint sw) {
+    static void sign_extend(sc_bv<WORD_64B*64> input, sc_bv<WORD_64B*64> &output, uint shift, uint sw) {
         switch (shift) {
             case 1: for (int j = 0; j < 1; j++) if (int((sw+1)*size-2-j) > int(sw*size-1))  output[(sw+1)*size-2-j] = input[(sw+1)*size-2]; break;
             case 2: for (int j = 0; j < 2; j++) if (int((sw+1)*size-2-j) > int(sw*size-1))  output[(sw+1)*size-2-j] = input[(sw+1)*size-2]; break;
@@ -111,7 +128,7 @@ public:
         }
     }
 
-    void guard_keep_sign_extend(sc_bv<WORD_64B*64> input, sc_bv<WORD_64B*64> &output, uint size, uint shift) {
+    static void guard_keep_sign_extend(sc_bv<WORD_64B*64> input, sc_bv<WORD_64B*64> &output, uint size, uint shift) {
         switch (size) {
             case 3:
                 for (int i = 0; i < WORD_BITS/3; i++) {
@@ -0,0 +1,909 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Implementation of the standalone SoftSIMD engine. Each block mirrors the
+ * corresponding SystemC module, evaluated once per cycle in dependency order.
+ *
+ */
+
+#include "softsimd_engine.h"
+#include "swar_ops.h"
+
+#include <cstring>
+#include <iostream>
+
+#if ENGINE_SUPPORTED
+
+// Index of a VWR in an OPC_STORAGE or MUX value, VWR_NUM if it is not an existing VWR
+static uint vwr_num(OPC_STORAGE opc) {
+    uint n = uint(opc) - uint(OPC_STORAGE::VWR0);
+    return (opc >= OPC_STORAGE::VWR0 && n < VWR_NUM) ? n : VWR_NUM;
+}
+
+static uint vwr_num(MUX mux) {
+    uint n = uint(mux) - uint(MUX::VWR0);
+    return (mux >= MUX::VWR0 && n < VWR_NUM) ? n : VWR_NUM;
+}
+
+// Same as mask_unit, with the mask already replicated
+static void mask_op(const uint64_t *in, const uint64_t *mask, uint64_t *out, MASKOP op_sel) {
+    for (uint i = 0; i < WORD_64B; i++) {
+        switch (op_sel) {
+            case MASKOP::AND:   out[i] = in[i] & mask[i];   break;
+            case MASKOP::OR:    out[i] = in[i] | mask[i];   break;
+            case MASKOP::XOR:   out[i] = in[i] ^ mask[i];   break;
+            default:            out[i] = in[i];             break;
+        }
+    }
+}
+
+void softsimd_engine::reset() {
+    memset(ib, 0, sizeof(ib));
+    memset(srf, 0, sizeof(srf));
+    memset(mrf, 0, sizeof(mrf));
+    memset(csdrf, 0, sizeof(csdrf));
+    memset(csdrf_digits, 0, sizeof(csdrf_digits));
+    memset(R, 0, sizeof(R));
+    memset(vwr, 0, sizeof(vwr));
+    memset(ts_reg, 0, sizeof(ts_reg));
+
+    pc = 0;
+    loop_sta = loop_end = loop_num = loop_curr = 0;
+    itt_idx_reg = uint(MACRO_IDX::SAFE_STATE);
+    common_reg = 0;
+    decoding_reg = false;
+    nop_cnt = 0;
+
+    ms_state = ENGINE_MS::IDLE;
+    ms_idx = 0;
+    ms_size = SWSIZE::INV;
+    ms_src = OPC_STORAGE::SA;
+    ms_src_n = 0;
+    ms_dst = OPC_STORAGE::R3;
+    ms_dst_n = 0;
+    memset(&ms_csd, 0, sizeof(ms_csd));
+    ms_len = CSD_BITS / 2;
+}
+
+// Without commands, only a macroinstruction being decoded or a multiplication
+// change the state (the NOP counter is handled by skip())
+bool softsimd_engine::busy() const {
+    return decoding_reg || ms_state != ENGINE_MS::IDLE;
+}
+
+void softsimd_engine::skip(uint64_t cycles) {
+    nop_cnt = (cycles >= nop_cnt) ? 0 : nop_cnt - cycles;
+}
+
+// Index of the S&A microinstruction for the multiplication sequencer
+static uint ms_sa_index(ADDOP op, uint shift) {
+#if (INSTR_FORMAT == BASE_FORMAT)
+    (void) shift;
+    return uint(mult_seq_microinstr[uint(op)]);
+#elif (INSTR_FORMAT == ENCODED_SHIFT_FORMAT)
+    return uint(mult_seq_microinstr[uint(op)][shift]);
+#endif
+}
+
+void softsimd_engine::ms_comb(bool enable, uint64_t macroinstr, const ctrl_signals &ctrl, ms_signals &ms) {
+    uint offset, csd_addr;
+    bool neg;
+    const csd_digits *csd;
+    static const csd_digits zeros_csd = {};
+
+    // Default signals for registers
+    ms.idx_nxt = ms_idx;
+    ms.size_nxt = ms_size;
+    ms.src_nxt = ms_src;
+    ms.src_n_nxt = ms_src_n;
+    ms.dst_nxt = ms_dst;
+    ms.dst_n_nxt = ms_dst_n;
+    ms.csd_nxt = ms_csd;
+    ms.len_nxt = ms_len;
+    bool first_found = false;
+
+    // Default outputs
+    ms.mov_valid = false;
+    ms.mov_src = OPC_STORAGE::SA;
+    ms.mov_src_n = 0;
+    ms.sa_valid = false;
+    ms.sa_index = ms_sa_index(ADDOP::NOP, 0);
+    ms.sa_size = ms_size;
+    ms.sa_shift = 0;
+    ms.sa_src0 = OPC_STORAGE::R3;
+    ms.sa_dst = OPC_STORAGE::R3;
+    ms.mov_dst_n = 0;
+
+#if STATIC_CSD_LEN
+    if (ctrl.csd_len_en) {
+        ms.len_nxt = ctrl.csd_len;
+    }
+#endif
+
+    switch (ms_state) {
+        case ENGINE_MS::IDLE:
+        case ENGINE_MS::FIND_NONZERO:
+            if (ms_state == ENGINE_MS::IDLE) {
+                if (!enable) {
+                    break;
+                }
+                // If starting new multiplication, register CSD input and DST
+                csd_addr = get_ms_csd_addr(macroinstr);
+                csd = (csd_addr < CSD_ENTRIES) ? &csdrf_digits[csd_addr] : &zeros_csd;
+                ms.size_nxt = get_ms_size(macroinstr);
+                ms.src_nxt = get_ms_src(macroinstr);
+                ms.src_n_nxt = get_ms_src_n(macroinstr);
+                ms.dst_nxt = get_ms_dst(macroinstr);
+                ms.dst_n_nxt = get_ms_dst_n(macroinstr);
+                ms.csd_nxt = *csd;
+#if !STATIC_CSD_LEN
+                ms.len_nxt = ctrl.csd_len;
+#endif
+            } else {
+                csd = &ms_csd;
+            }
+            // Update index for next window in case non-zero bits are not found
+            ms.idx_nxt = ms_idx + SA_MAX_SHIFT*2;
+            // Find first non-zero bit, the first window of a new multiplication is at 0
+            if (csd_find(*csd, (ms_state == ENGINE_MS::IDLE) ? 0 : ms_idx, &offset, &neg)) {
+                ms.mov_valid = true;
+                ms.mov_src = ms.src_nxt;
+                ms.mov_src_n = ms.src_n_nxt;
+                ms.sa_index = ms_sa_index(neg ? ADDOP::INV : ADDOP::NOP, 0);
+                ms.sa_shift = 0;
+                ms.sa_valid = true;
+                if (ms_state == ENGINE_MS::IDLE) {
+                    ms.sa_size = ms.size_nxt;
+                }
+                ms.sa_src0 = OPC_STORAGE::VWR;
+                ms.sa_dst = OPC_STORAGE::R3;
+                first_found = true;
+                ms.idx_nxt = ms_idx + 2*offset + 2;
+            }
+        break;
+        case ENGINE_MS::ZERO_MULT:      // All bits are zero in CSD multiplier
+            ms.sa_valid = true;
+            ms.sa_index = ms_sa_index(ADDOP::NOP, 0);
+            ms.sa_shift = 0;
+            ms.sa_src0 = OPC_STORAGE::ZERO;
+            ms.sa_dst = OPC_STORAGE::R3;
+        break;
+        case ENGINE_MS::GEN_SA:         // Generating sequence of shifts and add after first non-zero bit
+            ms.idx_nxt = ms_idx + SA_MAX_SHIFT*2;
+            ms.sa_valid = true;
+            // Default max shift in case non-zero bit are not found
+            ms.sa_shift = ((ms_len - ms_idx/2) < 3) ? (ms_len - ms_idx/2) : 3;
+            ms.sa_index = ms_sa_index(ADDOP::NOP, ms.sa_shift);
+            ms.sa_src0 = OPC_STORAGE::R3;
+            ms.sa_dst = OPC_STORAGE::R3;
+            // Find next non-zero bit
+            if (csd_find(ms_csd, ms_idx, &offset, &neg)) {
+                ms.sa_shift = offset + 1;
+                ms.sa_index = ms_sa_index(neg ? ADDOP::SUB : ADDOP::ADD, ms.sa_shift);
+                ms.idx_nxt = ms_idx + 2*offset + 2;
+            }
+        break;
+        case ENGINE_MS::WRITE_NOR3:     // Write multiplication result to R1 and/or R2
+            ms.sa_valid = true;
+            ms.sa_index = ms_sa_index(ADDOP::NOP, 0);
+            ms.sa_shift = 0;
+            ms.sa_src0 = OPC_STORAGE::R3;
+            if (is_vwr(ms_dst)) {
+                ms.mov_valid = true;
+                ms.mov_src = OPC_STORAGE::SA;
+            }
+            ms.sa_dst = ms_dst;
+            ms.mov_dst_n = ms_dst_n;
+        break;
+    }
+
+    // FSM, same as fsm_method
+    ms.state_nxt = ms_state;
+    ms.idx_rst = false;
+    switch (ms_state) {
+        case ENGINE_MS::IDLE:
+            if (enable) {
+                ms.state_nxt = first_found ? ENGINE_MS::GEN_SA : ENGINE_MS::FIND_NONZERO;
+            }
+        break;
+        case ENGINE_MS::FIND_NONZERO:
+            if (first_found) {
+                if (ms.idx_nxt < 2u*ms_len) {
+                    ms.state_nxt = ENGINE_MS::GEN_SA;
+                } else if (ms_dst == OPC_STORAGE::R3) {
+                    ms.state_nxt = ENGINE_MS::IDLE;
+                    ms.idx_rst = true;
+                } else {
+                    ms.state_nxt = ENGINE_MS::WRITE_NOR3;
+                }
+            } else if (ms.idx_nxt >= 2u*ms_len) {
+                ms.state_nxt = ENGINE_MS::ZERO_MULT;
+            }
+        break;
+        case ENGINE_MS::ZERO_MULT:
+            if (ms_dst == OPC_STORAGE::R3) {
+                ms.state_nxt = ENGINE_MS::IDLE;
+                ms.idx_rst = true;
+            } else {
+                ms.state_nxt = ENGINE_MS::WRITE_NOR3;
+            }
+        break;
+        case ENGINE_MS::GEN_SA:
+            if (ms.idx_nxt >= 2u*ms_len) {
+                if (ms_dst == OPC_STORAGE::R3) {
+                    ms.state_nxt = ENGINE_MS::IDLE;
+                    ms.idx_rst = true;
+                } else {
+                    ms.state_nxt = ENGINE_MS::WRITE_NOR3;
+                }
+            }
+        break;
+        case ENGINE_MS::WRITE_NOR3:
+            ms.state_nxt = ENGINE_MS::IDLE;
+            ms.idx_rst = true;
+        break;
+    }
+}
+
+void softsimd_engine::decode_mov(uint16_t microinstr, uint32_t fields, const ms_signals &ms, const engine_cmd &cmd, bool rf_access,
+                                 bool decode_en, bool data_from_pm, ctrl_signals &ctrl) {
+    MOP mop;
+    OPC_STORAGE dst, src, dst_sa;
+    uint imm, dst_n_sa, n;
+    MUX rd_from_mux = MUX::EXT;
+
+    // Default values
+    ctrl.nop_cnt_nxt = nop_cnt ? nop_cnt - 1 : 0;
+    ctrl.pc_rst = false;
+    ctrl.ib_wr_en = ctrl.srf_wr_en = ctrl.mrf_wr_en = ctrl.csdrf_wr_en = false;
+    ctrl.ts_in_en = ctrl.ts_out_en = false;
+    ctrl.ts_out_start = 0;
+    ctrl.ts_out_mode = TS_MODE::NOP;
+    ctrl.ts_shf_from = MUX::EXT;
+    for (uint i = 0; i < VWR_NUM; i++) {
+        ctrl.vwr_enable[i] = ctrl.vwr_wr_nrd[i] = ctrl.vwr_d_nm[i] = ctrl.vwr_mask_en[i] = false;
+        ctrl.vwr_mask[i] = 0;
+        ctrl.vwr_idx[i] = 0;
+        ctrl.vwr_from[i] = MUX::EXT;
+    }
+    ctrl.idm_sa_op1_from = MUX::VWR0;
+    ctrl.dram_out_en = false;
+    ctrl.dram_from = MUX::EXT;
+
+    // Write to RFs from host
+    if (rf_access) {
+        uint rowcol = ((cmd.row_addr & ((1 << (ROW_BITS - 1)) - 1)) << COL_BITS) | (cmd.col_addr & ((1 << COL_BITS) - 1));
+        switch (RF_SEL((rowcol >> RF_ADDR_BITS) & ((1 << RF_SEL_BITS) - 1))) {
+            case RF_SEL::IB:    ctrl.ib_wr_en = true;       break;
+            case RF_SEL::SRF:   ctrl.srf_wr_en = true;      break;
+            case RF_SEL::MRF:   ctrl.mrf_wr_en = true;      break;
+            case RF_SEL::CSDRF: ctrl.csdrf_wr_en = true;    break;
+            default:                                        break;
+        }
+    }
+
+    if (!decode_en) {
+        return;
+    }
+
+    decode_mov_microinstr(microinstr, fields, &mop, &dst, &src, &imm, &dst_sa, &dst_n_sa);
+    if (data_from_pm)   src = OPC_STORAGE::PM;
+
+    if (ms.mov_valid) {
+        if (is_vwr(ms.sa_dst)) {
+            mop = MOP::MOV_SAWB;
+            dst = OPC_STORAGE::SA;
+        } else if (is_vwr(ms.mov_src)) {
+            mop = MOP::MOV;
+            dst = OPC_STORAGE::SAR0;
+        }
+        src = ms.mov_src;
+        imm = ms.mov_src_n;
+        dst_sa = ms.sa_dst;
+        dst_n_sa = ms.mov_dst_n;
+    }
+
+    switch (mop) {
+        case MOP::NOP:
+            ctrl.nop_cnt_nxt = imm - 1;
+        break;
+
+        case MOP::EXIT:
+            ctrl.pc_rst = true;
+        break;
+
+        case MOP::DRAM_RD:  // Assume in this cycle the bank already pushed the data to IO
+            if ((n = vwr_num(dst)) < VWR_NUM) {
+                ctrl.vwr_enable[n] = true;
+                ctrl.vwr_wr_nrd[n] = true;
+                ctrl.vwr_mask_en[n] = true;
+                ctrl.vwr_mask[n] = imm;
+                ctrl.vwr_d_nm[n] = false;
+                ctrl.vwr_from[n] = MUX::DRAM;
+            }
+        break;
+
+        case MOP::DRAM_WR:
+            if ((n = vwr_num(src)) < VWR_NUM) {
+                ctrl.vwr_enable[n] = true;
+                ctrl.vwr_wr_nrd[n] = false;
+                ctrl.vwr_d_nm[n] = true;
+                ctrl.vwr_mask_en[n] = true;
+                ctrl.vwr_mask[n] = imm;
+                ctrl.dram_out_en = true;
+                ctrl.dram_from = MUX(uint(MUX::VWR0) + n);
+            }
+        break;
+
+        case MOP::MOV:
+        case MOP::MOV_SAWB:
+            if (src == OPC_STORAGE::R3) {
+                rd_from_mux = MUX::R3;
+            } else if (src == OPC_STORAGE::SA) {
+                rd_from_mux = MUX::SA;
+            } else if (src == OPC_STORAGE::PM) {
+                rd_from_mux = MUX::PM;
+            } else if ((n = vwr_num(src)) < VWR_NUM) {
+                ctrl.vwr_enable[n] = true;
+                ctrl.vwr_wr_nrd[n] = false;
+                ctrl.vwr_d_nm[n] = false;
+                ctrl.vwr_idx[n] = imm;
+                rd_from_mux = MUX(uint(MUX::VWR0) + n);
+            }
+            if (dst == OPC_STORAGE::R0) {
+                ctrl.reg_en[0] = true;
+                ctrl.reg_from[0] = rd_from_mux;
+            } else if (dst == OPC_STORAGE::SA) {
+                ctrl.idm_sa_op1_from = rd_from_mux;
+            } else if (dst == OPC_STORAGE::SAR0 && mop == MOP::MOV) {
+                ctrl.idm_sa_op1_from = rd_from_mux;
+                ctrl.reg_en[0] = true;
+                ctrl.reg_from[0] = rd_from_mux;
+            } else if ((n = vwr_num(dst)) < VWR_NUM) {
+                ctrl.vwr_enable[n] = true;
+                ctrl.vwr_wr_nrd[n] = true;
+                ctrl.vwr_d_nm[n] = true;
+                ctrl.vwr_idx[n] = imm;
+                ctrl.vwr_from[n] = rd_from_mux;
+            }
+            // Perform the writeback from SA to VWR
+            if (mop == MOP::MOV_SAWB && dst_sa != dst && (n = vwr_num(dst_sa)) < VWR_NUM) {
+                ctrl.vwr_enable[n] = true;
+                ctrl.vwr_wr_nrd[n] = true;
+                ctrl.vwr_d_nm[n] = true;
+                ctrl.vwr_idx[n] = dst_n_sa;
+                ctrl.vwr_from[n] = MUX::SA;
+            }
+        break;
+
+        case MOP::TS_FILL:
+            ctrl.ts_in_en = true;
+            ctrl.ts_out_mode = (TS_MODE) ((imm >> TS_STA_BITS) & ((1 << TS_MODE_BITS) - 1));
+            ctrl.ts_out_start = imm & ((1 << TS_STA_BITS) - 1);
+            if ((n = vwr_num(src)) < VWR_NUM) {
+                ctrl.ts_shf_from = MUX(uint(MUX::VWR0) + n);
+                ctrl.vwr_enable[n] = true;
+                ctrl.vwr_wr_nrd[n] = false;
+                ctrl.vwr_d_nm[n] = true;
+            } else {
+                ctrl.ts_in_en = false;  // If not from VWR, do nothing
+            }
+        break;
+
+#if DRAM_SHUFFLE
+        case MOP::TS_FILL_DRAM:
+            ctrl.ts_in_en = true;
+            ctrl.ts_out_mode = (TS_MODE) ((imm >> TS_STA_BITS) & ((1 << TS_MODE_BITS) - 1));
+            ctrl.ts_out_start = imm & ((1 << TS_STA_BITS) - 1);
+            ctrl.ts_shf_from = MUX::DRAM;
+        break;
+#endif
+
+        case MOP::TS_RLS:
+            ctrl.ts_out_en = true;
+            if ((n = vwr_num(dst)) < VWR_NUM) {
+                ctrl.vwr_enable[n] = true;
+                ctrl.vwr_wr_nrd[n] = true;
+                ctrl.vwr_d_nm[n] = false;
+                ctrl.vwr_from[n] = MUX::TILESH;
+            } else if (!is_vwr(dst)) {
+                ctrl.ts_out_en = false; // If not to VWR, do nothing
+            }
+        break;
+
+        default:
+        break;
+    }
+}
+
+void softsimd_engine::decode_sa(uint16_t microinstr, uint32_t fields, const ms_signals &ms, bool decode_en, ctrl_signals &ctrl) {
+    ADDOP addop;
+    uint shift;
+    SWSIZE sw_len;
+    OPC_STORAGE dst, src0, src1;
+    bool reg_en[REG_NUM] = {false};
+
+    // Default values
+    ctrl.sa_en = false;
+    ctrl.sa_shift = 0;
+    ctrl.sa_size = SWSIZE::INV;
+    ctrl.sa_adder_en = ctrl.sa_neg_op1 = ctrl.sa_neg_op2 = false;
+    ctrl.idsa_sa_op1_from = MUX::R3;
+    ctrl.sa_op2_from = MUX::R0;
+
+    if (decode_en) {
+        decode_sa_microinstr(microinstr, fields, &addop, &shift, &sw_len, &dst, &src0, &src1);
+        if (ms.sa_valid) {
+            sw_len = ms.sa_size;
+#if (INSTR_FORMAT == BASE_FORMAT)
+            shift = ms.sa_shift;
+#endif
+            dst = ms.sa_dst;
+            src0 = ms.sa_src0;
+        }
+
+        ctrl.sa_en = true;
+        if (src0 == OPC_STORAGE::R3) {
+            ctrl.idsa_sa_op1_from = MUX::R3;
+        } else if (src0 == OPC_STORAGE::VWR) {
+            ctrl.idsa_sa_op1_from = MUX::VWR;
+        } else if (src0 == OPC_STORAGE::ZERO) {
+            ctrl.idsa_sa_op1_from = MUX::ZERO;
+        }
+        if (src1 == OPC_STORAGE::R0) {
+            ctrl.sa_op2_from = MUX::R0;
+        } else if (src1 == OPC_STORAGE::ZERO) {
+            ctrl.sa_op2_from = MUX::ZERO;
+        }
+        switch (dst) {
+            case OPC_STORAGE::R1:   reg_en[1] = true;                   break;
+            case OPC_STORAGE::R2:   reg_en[2] = true;                   break;
+            case OPC_STORAGE::R1R2: reg_en[1] = reg_en[2] = true;       break;
+            case OPC_STORAGE::R3:   reg_en[3] = true;                   break;
+            default:                                                    break;
+        }
+        ctrl.sa_shift = shift;
+        ctrl.sa_size = sw_len;
+        switch (addop) {
+            case ADDOP::ADD:
+                ctrl.sa_adder_en = true;
+            break;
+            case ADDOP::SUB:
+                ctrl.sa_adder_en = true;
+                ctrl.sa_neg_op2 = true;
+            break;
+            case ADDOP::INV:
+                ctrl.sa_adder_en = true;
+                ctrl.sa_neg_op1 = true;
+                ctrl.sa_op2_from = MUX::ZERO;
+            break;
+            default:
+            break;
+        }
+    }
+
+    // Coalesce with the other decoders, as the control_unit output_method
+    for (uint i = 0; i < REG_NUM; i++) {
+        if (reg_en[i]) {
+            ctrl.reg_en[i] = true;
+            ctrl.reg_from[i] = ctrl.reg_from[i] | MUX::SA;
+        }
+    }
+}
+
+void softsimd_engine::decode_pm(uint16_t microinstr, uint32_t fields, bool decode_en, ctrl_signals &ctrl) {
+    MASKOP maskop;
+    OPC_STORAGE dst, src0, src1;
+    SWREPACK repack;
+    uint pack_sta, shift;
+    bool perm;
+
+    // Default values
+    ctrl.pm_en = false;
+    ctrl.pm_repack = SWREPACK::INV;
+    ctrl.pm_in_start = 0;
+    ctrl.pm_op_sel = MASKOP::NOP;
+    ctrl.pm_shift = 0;
+    ctrl.pm_out_to_vwr = false;
+
+    if (decode_en) {
+        decode_pm_microinstr(microinstr, fields, &maskop, &dst, &perm, &src0, &src1, &repack, &pack_sta, &shift);
+        ctrl.pm_en = true;
+        if (dst == OPC_STORAGE::R3) {
+            ctrl.reg_en[3] = true;
+            ctrl.reg_from[3] = ctrl.reg_from[3] | MUX::PM;
+        } else if (dst == OPC_STORAGE::VWR) {
+            ctrl.pm_out_to_vwr = true;
+        }
+        ctrl.pm_repack = repack;
+        if (perm && repack != SWREPACK::INV) {
+            ctrl.pm_in_start = pack_sta + WORD_BITS/swsize_to_uint((repack_to_insize(repack)));
+        } else {
+            ctrl.pm_in_start = pack_sta;
+        }
+        ctrl.pm_op_sel = maskop;
+        ctrl.pm_shift = shift;
+    }
+}
+
+bool softsimd_engine::step(const engine_cmd &cmd, const uint64_t *dram_in, uint64_t *dram_out) {
+    uint i, n;
+    ctrl_signals ctrl;
+    ms_signals ms;
+    static const uint64_t zeros_long[VWR_64B] = {0};
+    static const uint64_t zeros_word[WORD_64B] = {0};
+
+    if (!dram_in) {
+        dram_in = zeros_long;
+    }
+
+    // ** INTERFACE UNIT **
+    uint rmsb = (cmd.row_addr >> (ROW_BITS - 1)) & 1;
+    uint rowcol = ((cmd.row_addr & ((1 << (ROW_BITS - 1)) - 1)) << COL_BITS) | (cmd.col_addr & ((1 << COL_BITS) - 1));
+    uint rf_sel = (rowcol >> RF_ADDR_BITS) & ((1 << RF_SEL_BITS) - 1);
+    bool decode_en = false, rf_access = false;
+    ctrl.rf_addr = rowcol & ((1 << RF_ADDR_BITS) - 1);
+    ctrl.data_out = 0;
+    ctrl.loop_reg_en = false;
+    ctrl.loop_sta = ctrl.loop_end = ctrl.loop_num = 0;
+    ctrl.csd_len_en = false;
+    ctrl.csd_len = 0;
+    if (!rmsb) {    // PIM mode, enable instruction decoding if RD/WR command
+        decode_en = cmd.RD || cmd.WR;
+    } else if (rf_sel < uint(RF_SEL::VWR)) {
+        ctrl.data_out = cmd.DQ;
+        rf_access = cmd.WR && !cmd.RD;
+    } else if (rf_sel == uint(RF_SEL::LOOP_REG) && cmd.WR && !cmd.RD) {
+        ctrl.loop_reg_en = true;
+        ctrl.loop_sta = (cmd.DQ & 0x0000FFFF00000000) >> 32;
+        ctrl.loop_end = (cmd.DQ & 0x00000000FFFF0000) >> 16;
+        ctrl.loop_num = (cmd.DQ & 0x000000000000FFFF);
+#if STATIC_CSD_LEN
+    } else if (rf_sel == uint(RF_SEL::CSD_LEN) && cmd.WR && !cmd.RD) {
+        ctrl.csd_len_en = true;
+        ctrl.csd_len = cmd.DQ;
+#endif
+    }
+
+    // ** CONTROL UNIT **
+    bool nop_active = nop_cnt != 0;
+    uint64_t macroinstr = (pc < IB_ENTRIES) ? ib[pc] : 0;
+    uint macro_itt_idx = (macroinstr >> SHIFT_ITT_IDX) & ((1 << ITT_IDX_BITS) - 1);
+    uint itt_idx = itt_idx_reg;
+    uint common = common_reg;
+    uint itt_idx_nxt = uint(MACRO_IDX::SAFE_STATE);
+    bool decoding_nxt = decoding_reg;
+    ctrl.count_en = false;
+    if ((decode_en && !nop_active) || decoding_reg) {
+        decoding_nxt = true;
+        if (decode_en && !nop_active) {
+            itt_idx_nxt = macro_itt_idx + 1;
+            itt_idx = macro_itt_idx;
+            ctrl.count_en = true;
+            common = macroinstr & ((1UL << SHIFT_ITT_IDX) - 1);
+        } else {
+            itt_idx_nxt = itt_idx_reg + 1;
+        }
+        if (itt_mov_contents[itt_idx < uint(MACRO_IDX::MAX) ? itt_idx : 0].stop) {
+            itt_idx_nxt = uint(MACRO_IDX::SAFE_STATE);
+            decoding_nxt = false;
+        }
+    }
+
+    // ITT translation and fields for each DLB
+    uint itt_rom_idx = (itt_idx < uint(MACRO_IDX::MAX)) ? itt_idx : 0;
+    const itt_field &ittm = itt_mov_contents[itt_rom_idx];
+    const itt_field &ittsa = itt_sa_contents[itt_rom_idx];
+    const itt_field &ittpm = itt_pm_contents[itt_rom_idx];
+    uint32_t mov_fields, sa_fields, pm_fields;
+    unpack_fields(common, ittm.valid, ittsa.valid, ittpm.valid, &mov_fields, &sa_fields, &pm_fields);
+
+    // Multiplication sequencer
+    ms_comb(itt_idx == uint(MACRO_IDX::VFUX_MUL), macroinstr, ctrl, ms);
+
+    // DLB indices and decode enables
+    uint dlbm_index = ittm.addr;
+    uint dlbsa_index = ms.sa_valid ? ms.sa_index : ittsa.addr;
+    uint dlbpm_index = ittpm.addr;
+    bool idm_decode_en = ms.mov_valid || (ittm.valid && !nop_active);
+    bool idsa_decode_en = ms.sa_valid || (ittsa.valid && !nop_active);
+    bool idpm_decode_en = ittpm.valid && !nop_active;
+    uint16_t mov_micro = dlb_mov_contents[dlbm_index < uint(DLB_MOV_IDX::MAX) ? dlbm_index : 0];
+    uint16_t sa_micro = dlb_sa_contents[dlbsa_index < uint(DLB_SA_IDX::MAX) ? dlbsa_index : 0];
+    uint16_t pm_micro = dlb_pm_contents[dlbpm_index < uint(DLB_PM_IDX::MAX) ? dlbpm_index : 0];
+
+    // ** INSTRUCTION DECODERS **
+    // Register enables are coalesced from the three decoders, as in the control_unit
+    for (i = 0; i < REG_NUM; i++) {
+        ctrl.reg_en[i] = false;
+        ctrl.reg_from[i] = MUX::EXT;
+    }
+    decode_pm(pm_micro, pm_fields, idpm_decode_en, ctrl);
+    decode_mov(mov_micro, mov_fields, ms, cmd, rf_access, idm_decode_en, ctrl.pm_out_to_vwr, ctrl);
+    decode_sa(sa_micro, sa_fields, ms, idsa_decode_en, ctrl);
+    MUX sa_op1_from = (ctrl.idsa_sa_op1_from == MUX::VWR) ? ctrl.idm_sa_op1_from : ctrl.idsa_sa_op1_from;
+
+    // ** DATAPATH **
+    // VWR outputs
+    const uint64_t *lport_out[VWR_NUM];
+    const uint64_t *sport_out[VWR_NUM];
+    uint64_t sport_buf[VWR_NUM][WORD_64B];
+    for (i = 0; i < VWR_NUM; i++) {
+        lport_out[i] = (ctrl.vwr_enable[i] && !ctrl.vwr_wr_nrd[i]) ? vwr[i] : zeros_long;
+        if (!ctrl.vwr_d_nm[i] && !ctrl.vwr_wr_nrd[i]) {
+            uint64_t *word_out = sport_buf[i];
+            packed_copy(word_out, 0, vwr[i], ((ctrl.vwr_idx[i] < WORDS_PER_VWR) ? ctrl.vwr_idx[i] : 0) * WORD_BITS, WORD_BITS);
+            sport_out[i] = word_out;
+        } else {
+            sport_out[i] = zeros_word;
+        }
+    }
+
+    // Shift & Add
+    uint64_t shift_out[WORD_64B], sa_out[WORD_64B];
+    const uint64_t *sa_op1 = ((n = vwr_num(sa_op1_from)) < VWR_NUM) ? sport_out[n] : (sa_op1_from == MUX::ZERO) ? zeros_word : R[3];
+    const uint64_t *sa_op2 = R[0];
+    if (ctrl.sa_op2_from == MUX::ZERO) {
+        sa_op2 = zeros_word;
+    } else if (ctrl.sa_op2_from == MUX::SRF) {
+        sa_op2 = srf_rep.get(srf[0]);
+    }
+    if (ctrl.sa_en) {
+        uint size = swsize_to_uint(ctrl.sa_size);
+        swar_right_shift(sa_op1, shift_out, ctrl.sa_shift, size, SA_MAX_SHIFT);
+        if (ctrl.sa_adder_en) {
+#if SA_AND_OR
+            swar_sa_add(shift_out, sa_op2, sa_out, size, ctrl.sa_neg_op1, ctrl.sa_neg_op2);
+#else
+            swar_add_sub(shift_out, sa_op2, sa_out, ctrl.sa_neg_op1, ctrl.sa_neg_op2);
+#endif
+        } else {
+            memcpy(sa_out, shift_out, sizeof(sa_out));
+        }
+    } else {
+        memset(sa_out, 0, sizeof(sa_out));
+    }
+
+    // Pack & Mask
+    uint64_t pack_out[WORD_64B], mask_out[WORD_64B], pm_out[WORD_64B];
+    if (ctrl.pm_en) {
+        uint in_size = swsize_to_uint(repack_to_insize(ctrl.pm_repack));
+        uint out_size = swsize_to_uint(repack_to_outsize(ctrl.pm_repack));
+        swar_repack(R[1], R[2], pack_out, in_size, out_size, ctrl.pm_in_start);
+        mask_op(pack_out, mrf_rep.get(mrf[0]), mask_out, ctrl.pm_op_sel);
+        swar_right_shift(mask_out, pm_out, ctrl.pm_shift, out_size, PM_MAX_SHIFT);
+    } else {
+        memset(pm_out, 0, sizeof(pm_out));
+    }
+
+    // Tile shuffler
+    const uint64_t *ts_in = zeros_long;
+    if ((n = vwr_num(ctrl.ts_shf_from)) < VWR_NUM) {
+        ts_in = lport_out[n];
+    } else if (ctrl.ts_shf_from == MUX::DRAM) {
+        ts_in = dram_in;
+    }
+    uint64_t ts_buf[VWR_64B];
+    bool ts_latch = ctrl.ts_in_en && ctrl.ts_out_start < WORDS_PER_VWR;
+    if (ts_latch) {
+        swar_tile_shuffle(ts_in, ts_buf, ctrl.ts_out_mode, ctrl.ts_out_start);
+    }
+    const uint64_t *ts_out = ctrl.ts_out_en ? ts_reg : zeros_long;
+
+    // DRAM output
+    bool dram_out_en = ctrl.dram_out_en;
+    if (dram_out) {
+        if (dram_out_en) {
+            n = vwr_num(ctrl.dram_from);
+            memcpy(dram_out, lport_out[n < VWR_NUM ? n : 0], VWR_64B*sizeof(uint64_t));
+        } else {
+            memset(dram_out, 0, VWR_64B*sizeof(uint64_t));
+        }
+    }
+
+    // Register inputs, taken before updating any state
+    uint64_t R_in[REG_NUM][WORD_64B];
+    n = vwr_num(ctrl.reg_from[0]);
+    memcpy(R_in[0], sport_out[n < VWR_NUM ? n : 0], sizeof(R_in[0]));
+    memcpy(R_in[1], sa_out, sizeof(R_in[1]));
+    memcpy(R_in[2], sa_out, sizeof(R_in[2]));
+    memcpy(R_in[3], (ctrl.reg_from[3] == MUX::PM) ? pm_out : sa_out, sizeof(R_in[3]));
+
+    // ** CLOCK EDGE **
+    // RFs
+    if (ctrl.ib_wr_en && ctrl.rf_addr < IB_ENTRIES) {
+        ib[ctrl.rf_addr] = ctrl.data_out;
+    }
+    if (ctrl.srf_wr_en && ctrl.rf_addr < SRF_ENTRIES) {
+        for (i = 0; i < MASK_64B; i++)
+            srf[ctrl.rf_addr][i] = ctrl.data_out;
+    }
+    if (ctrl.mrf_wr_en && ctrl.rf_addr < MASK_ENTRIES) {
+        for (i = 0; i < MASK_64B; i++)
+            mrf[ctrl.rf_addr][i] = ctrl.data_out;
+    }
+    if (ctrl.csdrf_wr_en && ctrl.rf_addr < CSD_ENTRIES) {
+        for (i = 0; i < CSD_64B; i++)
+            csdrf[ctrl.rf_addr][i] = ctrl.data_out;
+        csd_scan(csdrf[ctrl.rf_addr], csdrf_digits[ctrl.rf_addr]);
+    }
+
+    // PC and HW loop
+    uint pc_nxt = pc, loop_curr_nxt = loop_curr;
+    if (ctrl.pc_rst) {
+        pc_nxt = 0;
+    } else if (ctrl.count_en) {
+        pc_nxt = (pc < IB_ENTRIES - 1) ? pc + 1 : 0;
+        if (pc == loop_end && loop_curr + 1 < loop_num) {
+            pc_nxt = loop_sta;
+            loop_curr_nxt = loop_curr + 1;
+        } else if (pc == loop_end && loop_curr + 1 == loop_num) {
+            loop_curr_nxt = 0;
+        }
+    }
+    pc = pc_nxt;
+    loop_curr = loop_curr_nxt;
+    if (ctrl.loop_reg_en) {
+        loop_curr = 0;
+        loop_sta = ctrl.loop_sta;
+        loop_end = ctrl.loop_end;
+        loop_num = ctrl.loop_num;
+    }
+
+    // Control unit, NOP counter and multiplication sequencer
+    itt_idx_reg = itt_idx_nxt;
+    common_reg = common;
+    decoding_reg = decoding_nxt;
+    nop_cnt = ctrl.nop_cnt_nxt;
+    ms_state = ms.state_nxt;
+    ms_idx = ms.idx_rst ? 0 : ms.idx_nxt;
+    ms_size = ms.size_nxt;
+    ms_src = ms.src_nxt;
+    ms_src_n = ms.src_n_nxt;
+    ms_dst = ms.dst_nxt;
+    ms_dst_n = ms.dst_n_nxt;
+    ms_csd = ms.csd_nxt;
+    ms_len = ms.len_nxt;
+
+    // Datapath registers
+    for (i = 0; i < REG_NUM; i++) {
+        if (ctrl.reg_en[i]) {
+            memcpy(R[i], R_in[i], sizeof(R[i]));
+        }
+    }
+
+    // VWRs. A VWR being written is not driving its ports, so the inputs are still valid
+    for (i = 0; i < VWR_NUM; i++) {
+        if (!ctrl.vwr_enable[i] || !ctrl.vwr_wr_nrd[i]) {
+            continue;
+        }
+        if (ctrl.vwr_d_nm[i]) {     // Writing from the word port (demultiplex)
+            const uint64_t *word_in = zeros_word;
+            if (ctrl.vwr_from[i] == MUX::SA) {
+                word_in = sa_out;
+            } else if (ctrl.vwr_from[i] == MUX::PM) {
+                word_in = pm_out;
+            }
+            if (ctrl.vwr_idx[i] < WORDS_PER_VWR) {
+                packed_copy(vwr[i], ctrl.vwr_idx[i] * WORD_BITS, word_in, 0, WORD_BITS);
+            }
+        } else {                    // Writing from the wide port, masked by words if enabled
+            const uint64_t *wide_in = zeros_long;
+            if (ctrl.vwr_from[i] == MUX::TILESH) {
+                wide_in = ts_out;
+            } else if (ctrl.vwr_from[i] == MUX::DRAM) {
+                wide_in = dram_in;
+            } else if ((n = vwr_num(ctrl.vwr_from[i])) < VWR_NUM) {
+                wide_in = lport_out[n];
+            }
+            if (ctrl.vwr_mask_en[i]) {
+#if FLEXIBLE_MASK
+                uint64_t mask_in = ctrl.vwr_mask[i];
+#else
+                uint64_t mask_in = ctrl.vwr_mask[i] ? ((uint64_t) 1 << (ctrl.vwr_mask[i] - 1)) : ~(uint64_t) 0;
+#endif
+                for (uint j = 0; j < WORDS_PER_VWR && j < 64; j++) {
+                    if ((mask_in >> j) & 1) {
+                        packed_copy(vwr[i], j * WORD_BITS, wide_in, j * WORD_BITS, WORD_BITS);
+                    }
+                }
+            } else {
+                memcpy(vwr[i], wide_in, sizeof(vwr[i]));
+            }
+        }
+        if (WORDS_PER_VWR*WORD_BITS < VWR_BITS) {
+            packed_clear(vwr[i], WORDS_PER_VWR*WORD_BITS, VWR_BITS);
+        }
+    }
+
+    // Tile shuffler
+    if (ts_latch) {
+        memcpy(ts_reg, ts_buf, sizeof(ts_reg));
+    }
+
+    return dram_out_en;
+}
+
+bool softsimd_engine_pch::step(const engine_cmd &cmd, uint64_t (*dram_out)[VWR_64B]) {
+    bool out_en = false;
+    bool bank_in = bank_pending;
+
+    bank_pending = false;
+    for (uint i = 0; i < CORES_PER_PCH; i++) {
+        out_en |= pu[i].step(cmd, bank_in ? bank_data[i] : NULL, dram_out ? dram_out[i] : NULL);
+    }
+    cur_cycle++;
+    eval_cycles++;
+
+    return out_en;
+}
+
+void softsimd_engine_pch::idle_until(uint64_t cycle) {
+    engine_cmd idle = {false, false, 0, 0, 0};
+
+    while (cur_cycle < cycle) {
+        bool busy = bank_pending;
+        for (uint i = 0; i < CORES_PER_PCH; i++) {
+            busy |= pu[i].busy();
+        }
+        if (busy) {
+            step(idle, NULL);
+        } else {
+            for (uint i = 0; i < CORES_PER_PCH; i++) {
+                pu[i].skip(cycle - cur_cycle);
+            }
+            cur_cycle = cycle;
+        }
+    }
+}
+
+uint64_t softsimd_engine_pch::issue(uint64_t cycle, uint64_t addr, bool wr, const std::vector<uint64_t> &data,
+                                    uint64_t (*dram_out)[VWR_64B]) {
+    uint i, j;
+    engine_cmd cmd = {false, false, 0, 0, 0};
+    uint64_t issue_cycle;
+    bool bank_read = false;
+
+    last_read = cycle;
+    idle_until(cycle);
+
+    // Same command signals as the pch_driver
+    cmd.row_addr = (addr >> (RO_END)) & ((1UL << ROW_BITS) - 1);
+    cmd.col_addr = (addr >> (CO_END)) & ((1UL << COL_BITS) - 1);
+    if ((addr >> (RO_STA)) & 1) {     // Writing to the RFs
+        if (!wr) {
+            std::cout << "Warning: RF writing mode but saw a RD command" << std::endl;
+        } else {
+            cmd.WR = true;
+            cmd.DQ = data.empty() ? 0 : data.front();
+        }
+    } else if (!wr) {               // PIM execution, bank data in the next cycle
+        cmd.RD = true;
+        bank_read = !data.empty();
+    } else {
+        cmd.WR = true;
+    }
+
+    issue_cycle = cur_cycle;
+    step(cmd, wr ? dram_out : NULL);
+
+    if (bank_read) {
+        for (i = 0; i < CORES_PER_PCH; i++) {
+            for (j = 0; j < VWR_64B; j++) {
+                uint64_t word = (i*VWR_64B + j < data.size()) ? data[i*VWR_64B + j] : 0;
+                bank_data[i][j] = (64*(j+1) <= VWR_BITS) ? word : word & packed_lsb_mask(VWR_BITS - 64*j);
+            }
+        }
+        bank_pending = true;
+    }
+
+    return issue_cycle;
+}
+
+// The pch_driver waits 5 cycles after reading the last command
+uint64_t softsimd_engine_pch::finish() const {
+    return (cur_cycle > last_read + 5) ? cur_cycle : last_read + 5;
+}
+
+#endif  // ENGINE_SUPPORTED
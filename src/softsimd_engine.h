@@ -0,0 +1,186 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Standalone (SystemC-free) engine for SoftSIMD. Executes the macroinstructions
+ * in the IB with the ITT and DLB contents of the selected microcode, on the same
+ * state as the SystemC model but kept in packed 64-bit words. Each call to step()
+ * evaluates one clock cycle of a PU, and cycles where the PUs of a pseudo-channel
+ * are idle are skipped instead of evaluated.
+ *
+ */
+
+#ifndef SRC_SOFTSIMD_ENGINE_H_
+#define SRC_SOFTSIMD_ENGINE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "defs.h"
+#include "opcodes.h"
+#include "packed_bits.h"
+#include "swar_ops.h"
+#include "csd_digits.h"
+#include "microcode/common_format.h"
+#if (INSTR_FORMAT == BASE_FORMAT)
+#include "microcode/base_code.h"
+#elif (INSTR_FORMAT == ENCODED_SHIFT_FORMAT)
+#include "microcode/encoded_shift_code.h"
+#endif
+
+#if ENGINE_SUPPORTED
+
+// Same states as MS_FSM in the mult_sequencer
+enum class ENGINE_MS : uint {
+    IDLE, FIND_NONZERO, ZERO_MULT, GEN_SA, WRITE_NOR3
+};
+
+// Command seen by the PUs of a pseudo-channel in one cycle
+typedef struct engine_cmd {
+    bool RD, WR;        // DRAM commands
+    uint row_addr;      // Row address
+    uint col_addr;      // Column address
+    uint64_t DQ;        // Data from the DRAM controller
+} engine_cmd;
+
+// One SoftSIMD PU
+class softsimd_engine {
+public:
+
+    // Architectural state, same as the registers of the SystemC model
+    uint64_t ib[IB_ENTRIES];                    // Instruction buffer
+    uint64_t srf[SRF_ENTRIES][MASK_64B];        // Scalar RF
+    uint64_t mrf[MASK_ENTRIES][MASK_64B];       // Mask RF
+    uint64_t csdrf[CSD_ENTRIES][CSD_64B];       // CSD RF
+    uint64_t R[REG_NUM][WORD_64B];              // Datapath registers
+    uint64_t vwr[VWR_NUM][VWR_64B];             // VWRs
+    uint64_t ts_reg[VWR_64B];                   // Tile shuffler register
+
+    // Digit masks of the CSD RF entries, built when written
+    csd_digits csdrf_digits[CSD_ENTRIES];
+
+    // Replicated SRF and MRF masks, memoized by value
+    swar_rep_cache<SRF_ENTRIES> srf_rep;
+    swar_rep_cache<MASK_ENTRIES> mrf_rep;
+
+    // Control state
+    uint pc;                                    // Program counter
+    uint loop_sta, loop_end, loop_num, loop_curr;   // HW loop registers
+    uint itt_idx_reg;                           // ITT index being decoded
+    uint common_reg;                            // Common fields of the macroinstruction
+    bool decoding_reg;                          // Signals a macroinstruction being decoded
+    uint8_t nop_cnt;                            // Remaining cycles of the current NOP
+
+    // Multiplication sequencer state
+    ENGINE_MS ms_state;
+    uint ms_idx;
+    SWSIZE ms_size;
+    OPC_STORAGE ms_src, ms_dst;
+    uint ms_src_n, ms_dst_n;
+    csd_digits ms_csd;
+    uint8_t ms_len;
+
+    softsimd_engine() {
+        reset();
+    }
+
+    void reset();                       // Same state as after the reset of the SystemC model
+    bool busy() const;                  // True if the PU evaluates something without new commands
+    void skip(uint64_t cycles);         // Advances idle cycles without evaluating them
+    // Evaluates one cycle with the command and the data pushed by the bank (NULL if none).
+    // Returns true if the PU drives dram_out in this cycle
+    bool step(const engine_cmd &cmd, const uint64_t *dram_in, uint64_t *dram_out);
+
+private:
+
+    // Control signals of one cycle, as generated by the decoders
+    typedef struct ctrl_signals {
+        bool pc_rst, count_en;
+        bool loop_reg_en;
+        uint loop_sta, loop_end, loop_num;
+        bool csd_len_en;
+        uint8_t csd_len;
+        uint8_t nop_cnt_nxt;
+        bool ib_wr_en, srf_wr_en, mrf_wr_en, csdrf_wr_en;
+        uint rf_addr;
+        uint64_t data_out;
+        bool ts_in_en, ts_out_en;
+        uint ts_out_start;
+        TS_MODE ts_out_mode;
+        MUX ts_shf_from;
+        bool vwr_enable[VWR_NUM], vwr_wr_nrd[VWR_NUM], vwr_d_nm[VWR_NUM], vwr_mask_en[VWR_NUM];
+        uint64_t vwr_mask[VWR_NUM];
+        uint vwr_idx[VWR_NUM];
+        MUX vwr_from[VWR_NUM];
+        bool reg_en[REG_NUM];
+        MUX reg_from[REG_NUM];
+        MUX idm_sa_op1_from, idsa_sa_op1_from, sa_op2_from;
+        bool dram_out_en;
+        MUX dram_from;
+        bool sa_en, sa_adder_en, sa_neg_op1, sa_neg_op2;
+        uint sa_shift;
+        SWSIZE sa_size;
+        bool pm_en, pm_out_to_vwr;
+        SWREPACK pm_repack;
+        uint pm_in_start, pm_shift;
+        MASKOP pm_op_sel;
+    } ctrl_signals;
+
+    // Outputs of the multiplication sequencer and its next state
+    typedef struct ms_signals {
+        bool mov_valid, sa_valid;
+        OPC_STORAGE mov_src, sa_src0, sa_dst;
+        uint mov_src_n, mov_dst_n, sa_index, sa_shift;
+        SWSIZE sa_size;
+        ENGINE_MS state_nxt;
+        uint idx_nxt;
+        bool idx_rst;
+        SWSIZE size_nxt;
+        OPC_STORAGE src_nxt, dst_nxt;
+        uint src_n_nxt, dst_n_nxt;
+        csd_digits csd_nxt;
+        uint8_t len_nxt;
+    } ms_signals;
+
+    void ms_comb(bool enable, uint64_t macroinstr, const ctrl_signals &ctrl, ms_signals &ms);
+    void decode_mov(uint16_t microinstr, uint32_t fields, const ms_signals &ms, const engine_cmd &cmd, bool rf_access,
+                    bool decode_en, bool data_from_pm, ctrl_signals &ctrl);
+    void decode_sa(uint16_t microinstr, uint32_t fields, const ms_signals &ms, bool decode_en, ctrl_signals &ctrl);
+    void decode_pm(uint16_t microinstr, uint32_t fields, bool decode_en, ctrl_signals &ctrl);
+};
+
+// The PUs of a pseudo-channel, fed with the commands of a .sci trace with the
+// same timing as the pch_driver
+class softsimd_engine_pch {
+public:
+
+    softsimd_engine pu[CORES_PER_PCH];
+    uint64_t cur_cycle;     // Cycle evaluated by the next step
+    uint64_t last_read;     // Cycle of the last command read from the trace
+    uint64_t eval_cycles;   // Cycles actually evaluated
+    bool bank_pending;      // Bank data to be pushed in the next cycle
+    uint64_t bank_data[CORES_PER_PCH][VWR_64B];
+
+    softsimd_engine_pch() {
+        cur_cycle = 1;
+        last_read = 0;
+        eval_cycles = 0;
+        bank_pending = false;
+    }
+
+    // Evaluates one cycle of all PUs. dram_out receives the words driven by each PU.
+    // Returns true if a PU drives dram_out
+    bool step(const engine_cmd &cmd, uint64_t (*dram_out)[VWR_64B]);
+    // Advances without commands until cycle, only evaluating the cycles where a PU is active
+    void idle_until(uint64_t cycle);
+    // Issues a trace command, at its cycle or as soon as the previous one is done.
+    // The bank data words of a PIM RD are pushed in the next cycle. Returns the
+    // issue cycle; for a PIM WR, dram_out receives the words driven by each PU
+    uint64_t issue(uint64_t cycle, uint64_t addr, bool wr, const std::vector<uint64_t> &data, uint64_t (*dram_out)[VWR_64B]);
+    // Cycle at which the pch_driver finishes the simulation
+    uint64_t finish() const;
+};
+
+#endif  // ENGINE_SUPPORTED
+
+#endif /* SRC_SOFTSIMD_ENGINE_H_ */
@@ -12,12 +12,171 @@
 
 #ifndef __SYNTHESIS__
 
+#if FAST_BUSES
+
+// Same multiplexing as below, but the buses are point-to-point and two-valued:
+// every source is read from its own output and the *_from selects decide which
+// one reaches each destination, instead of resolving tristate drivers
 void softsimd_pu::comb_method() {
     uint i, j;
-    sc_bv<MASK_64B*64> scalar_aux;      // Holds parsed scalar
-    sc_bv<MASK_BITS> scalar_to_rep;     // Holds scalar before replication
-    sc_bv<WORD_64B*64> scalar_rep('0'); // Holds replicated scalar in SystemC bit-vector
-    uint64_t scalar[WORD_64B];          // Replicated scalar in 64-bit uint
+    uint64_t scalar_raw[MASK_64B];      // Holds scalar before replication
+    const uint64_t *scalar = NULL;      // Replicated scalar in 64-bit uint
+
+    packed_bv<VWR_BITS> zeros_long;                 // Undriven wide bus
+    packed_bv<WORD_BITS> to_vwr_narrow;             // Holds input to VWR muxes
+    const uint64_t *from_vwr_narrow[VWR_NUM];       // Points to the output of VWR muxes
+
+    // Replicate the scalar from the SRF, only the first time its value is read
+    if (sa_op2_from == MUX::SRF) {
+        for (i = 0; i < MASK_64B; i++) {
+            scalar_raw[i] = srf_out[i];
+        }
+        scalar = srf_rep.get(scalar_raw);
+    }
+
+    // The VWR word outputs are already packed
+    for (i = 0; i < VWR_NUM; i++) {
+        from_vwr_narrow[i] = vwr_muxed_out[i].read().w;
+    }
+
+    // Tile shuffler input multiplexer
+    switch (ts_shf_from) {
+        case MUX::VWR0:     ts_in = vwr_out[0];     break;
+        case MUX::VWR1:     ts_in = vwr_out[1];     break;
+#if VWR_NUM > 2
+        case MUX::VWR2:     ts_in = vwr_out[2];     break;
+#endif
+#if VWR_NUM > 3
+        case MUX::VWR3:     ts_in = vwr_out[3];     break;
+#endif
+        case MUX::DRAM:     ts_in = dram_in;        break;
+        default:            ts_in = zeros_long;     break;
+    }
+
+    // VWR input multiplexers. Depending on the origin, using word interface or very wide interface
+    for (i = 0; i < VWR_NUM; i++) {
+        to_vwr_narrow.clear();
+        switch (vwr_from[i]) {
+            case MUX::SA:
+                for (j=0; j<WORD_64B; j++) {
+                    to_vwr_narrow[j] = sa_out[j];
+                }
+            break;
+            case MUX::PM:
+                for (j=0; j<WORD_64B; j++) {
+                    to_vwr_narrow[j] = pm_out[j];
+                }
+            break;
+            default:
+            break;
+        }
+        vwr_muxed_in[i] = to_vwr_narrow;
+
+        switch (vwr_from[i]) {
+            case MUX::TILESH:   vwr_in[i] = ts_out;         break;
+            case MUX::VWR0:     vwr_in[i] = vwr_out[0];     break;
+            case MUX::VWR1:     vwr_in[i] = vwr_out[1];     break;
+#if VWR_NUM > 2
+            case MUX::VWR2:     vwr_in[i] = vwr_out[2];     break;
+#endif
+#if VWR_NUM > 3
+            case MUX::VWR3:     vwr_in[i] = vwr_out[3];     break;
+#endif
+            case MUX::DRAM:     vwr_in[i] = dram_in;        break;
+            default:            vwr_in[i] = zeros_long;     break;
+        }
+    }
+
+    // R0
+    for (j = 0; j < WORD_64B; j++) {
+        switch (reg_from[0]) {
+            case MUX::VWR0: R_in[0][j] = from_vwr_narrow[0][j]; break;
+            case MUX::VWR1: R_in[0][j] = from_vwr_narrow[1][j]; break;
+#if VWR_NUM > 2
+            case MUX::VWR2: R_in[0][j] = from_vwr_narrow[2][j]; break;
+#endif
+#if VWR_NUM > 3
+            case MUX::VWR3: R_in[0][j] = from_vwr_narrow[3][j]; break;
+#endif
+            default:        R_in[0][j] = from_vwr_narrow[0][j]; break;
+        }
+    }
+    // R1 and R2
+    for (j = 0; j < WORD_64B; j++) {
+        R_in[1][j] = sa_out[j];
+        R_in[2][j] = sa_out[j];
+    }
+    // R3
+    for (j = 0; j < WORD_64B; j++) {
+        switch (reg_from[3]) {
+            case MUX::SA:   R_in[3][j] = sa_out[j]; break;
+            case MUX::PM:   R_in[3][j] = pm_out[j]; break;
+            default:        R_in[3][j] = sa_out[j]; break;
+        }
+    }
+
+    // SRF, Mask RF and CSD RF input multiplexers
+    for (i = 0; i < MASK_64B; i++) {
+        srf_in[i] = cu_data_out;
+        mrf_in[i] = cu_data_out;
+    }
+    for (i = 0; i < CSD_64B; i++) {
+        csdrf_in[i] = cu_data_out;
+    }
+
+    // Shift & Add input multiplexers
+    for (i = 0; i < WORD_64B; i++) {
+        switch (sa_op1_from) {  // Input to shifter (A>>)
+            case MUX::ZERO: sa_op1[i] = 0;                      break;
+            case MUX::VWR0: sa_op1[i] = from_vwr_narrow[0][i];  break;
+            case MUX::VWR1: sa_op1[i] = from_vwr_narrow[1][i];  break;
+#if VWR_NUM > 2
+            case MUX::VWR2: sa_op1[i] = from_vwr_narrow[2][i];  break;
+#endif
+#if VWR_NUM > 3
+            case MUX::VWR3: sa_op1[i] = from_vwr_narrow[3][i];  break;
+#endif
+            case MUX::R3:   sa_op1[i] = R_out[3][i];            break;
+            default:        sa_op1[i] = R_out[3][i];            break;
+        }
+
+        switch (sa_op2_from) {  // Input to adder/sub (+/-B)
+            case MUX::ZERO: sa_op2[i] = 0;                      break;
+            case MUX::SRF:  sa_op2[i] = scalar[i];              break;
+            case MUX::R0:   sa_op2[i] = R_out[0][i];            break;
+            default:        sa_op2[i] = R_out[0][i];            break;
+        }
+    }
+
+    // Pack & Mask inputs
+    for (i = 0; i < WORD_64B; i++) {
+        pm_w1[i] = R_out[1][i];
+        pm_w2[i] = R_out[2][i];
+    }
+
+    // DRAM output multiplexer, only driven when enabled
+    if (dram_out_en) {
+        switch (dram_from) {
+            case MUX::VWR1:     dram_out = vwr_out[1];      break;
+#if VWR_NUM > 2
+            case MUX::VWR2:     dram_out = vwr_out[2];      break;
+#endif
+#if VWR_NUM > 3
+            case MUX::VWR3:     dram_out = vwr_out[3];      break;
+#endif
+            default:            dram_out = vwr_out[0];      break;
+        }
+    } else {
+        dram_out = zeros_long;
+    }
+}
+
+#else   // FAST_BUSES
+
+void softsimd_pu::comb_method() {
+    uint i, j;
+    uint64_t scalar_raw[MASK_64B];      // Holds scalar before replication
+    const uint64_t *scalar = NULL;      // Replicated scalar in 64-bit uint
 
     sc_lv<WORD_BITS> vwr_muxed_aux;             // Holds output of vwr_muxed
     sc_lv<WORD_64B*64> vwr_muxed_toparse('0');      // Holds output of vwr_muxed
@@ -29,22 +188,12 @@ void softsimd_pu::comb_method() {
 
     sc_bv<64> parse_aux;                // Used for parsing
 
-    // Replicate the scalar from the SRF
+    // Replicate the scalar from the SRF, only the first time its value is read
     if (sa_op2_from == MUX::SRF) {
         for (i = 0; i < MASK_64B; i++) {
-            parse_aux = srf_out[i];
-            scalar_aux.range((i+1)*64-1, i*64) = parse_aux;
-        }
-        scalar_to_rep = scalar_aux(MASK_BITS-1,0);
-        // Replicate scalar
-        for (i = 0; i < MASK_PER_WORD; i++) {
-            scalar_rep.range((i+1)*MASK_BITS-1,i*MASK_BITS) = scalar_to_rep;
-        }
-        // Parse replicated mask to 64-bit uint
-        for (i = 0; i < WORD_64B; i++) {
-            parse_aux.range(63,0) = scalar_rep.range((i+1)*64-1, i*64);
-            scalar[i] = parse_aux.to_uint64();
+            scalar_raw[i] = srf_out[i];
         }
+        scalar = srf_rep.get(scalar_raw);
     }
 
     // Parse between vwr_muxed (resolved vector) and the multiplexer input
@@ -231,7 +380,7 @@ void softsimd_pu::comb_method() {
     // Shift & Add input multiplexers
     for (i = 0; i < WORD_64B; i++) {
         switch (sa_op1_from) {  // Input to shifter (A>>)
-//            case MUX::ZERO: sa_op1[i] = 0;                      break;
+            case MUX::ZERO: sa_op1[i] = 0;                      break;
             case MUX::VWR0: sa_op1[i] = from_vwr_narrow[0][i];  break;
             case MUX::VWR1: sa_op1[i] = from_vwr_narrow[1][i];  break;
 #if !DUAL_BANK_INTERFACE
@@ -321,6 +470,8 @@ void softsimd_pu::comb_method() {
 
 }
 
+#endif  // FAST_BUSES
+
 #else   // __SYNTHESIS__
 
 void softsimd_pu::comb_method() {
@@ -554,7 +705,7 @@ void softsimd_pu::comb_method() {
     // Shift & Add input multiplexers
     for (i = 0; i < WORD_64B; i++) {
         switch (sa_op1_from) {  // Input to shifter (A>>)
-//            case MUX::ZERO: sa_op1[i] = 0;                      break;
+            case MUX::ZERO: sa_op1[i] = 0;                      break;
             case MUX::VWR0: sa_op1[i] = from_vwr_narrow[0][i];  break;
             case MUX::VWR1: sa_op1[i] = from_vwr_narrow[1][i];  break;
 #if !DUAL_BANK_INTERFACE
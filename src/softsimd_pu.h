@@ -21,6 +21,7 @@
 #include "tile_shuffler.h"
 #include "tristate_buffer.h"
 #include "vwr.h"
+#include "vwr_packed.h"
 
 #if RECORDING
 #include <iostream>
@@ -59,6 +60,9 @@ public:
 #if DUAL_BANK_INTERFACE
     sc_inout_rv<DRAM_BITS>      even_bus;   // Direct data in/out to the even bank
     sc_inout_rv<DRAM_BITS>      odd_bus;    // Direct data in/out to the odd bank
+#elif FAST_BUSES
+    sc_in<packed_bv<DRAM_BITS> >    dram_in;    // Direct data in from the DRAM
+    sc_out<packed_bv<DRAM_BITS> >   dram_out;   // Direct data out to the DRAM (zero when not enabled)
 #else
     sc_inout_rv<DRAM_BITS>      dram_bus;   // Direct data in/out to the DRAM
 #endif
@@ -73,7 +77,9 @@ public:
 #else
     sc_signal<bool>                 dram_out_en;
     sc_signal<MUX>                  dram_from;
+#if !FAST_BUSES
     sc_signal<sc_lv<DRAM_BITS> >    to_dram;
+#endif
 #endif
     // Instruction buffer
     sc_signal<bool>     ib_wr_en;
@@ -84,15 +90,24 @@ public:
     sc_signal<uint>         ts_out_start;
     sc_signal<TS_MODE>      ts_mode;
     sc_signal<MUX>          ts_shf_from;
+#if FAST_BUSES
+    sc_signal<packed_bv<VWR_BITS> > ts_in, ts_out;
+#else
     sc_signal_rv<VWR_BITS>  ts_inout;
+#endif
     // VWRs
     sc_signal<bool>         vwr_enable[VWR_NUM], vwr_wr_nrd[VWR_NUM], vwr_d_nm[VWR_NUM];
     sc_signal<uint>         vwr_idx[VWR_NUM];
     sc_signal<bool>         vwr_mask_en[VWR_NUM];
     sc_signal<uint64_t>     vwr_mask[VWR_NUM];
     sc_signal<MUX>          vwr_from[VWR_NUM];
+#if FAST_BUSES
+    sc_signal<packed_bv<VWR_BITS> >     vwr_in[VWR_NUM], vwr_out[VWR_NUM];
+    sc_signal<packed_bv<WORD_BITS> >    vwr_muxed_in[VWR_NUM], vwr_muxed_out[VWR_NUM];
+#else
     sc_signal_rv<VWR_BITS>  vwr_inout[VWR_NUM];
     sc_signal_rv<WORD_BITS> vwr_muxed[VWR_NUM];
+#endif
 #if VWR_DRAM_CLK > 1
     sc_signal<bool>         vwr_dram_d_nm[VWR_NUM];
     sc_signal<uint>         vwr_dram_idx;
@@ -107,6 +122,7 @@ public:
     sc_signal<bool>     srf_wr_en;
     sc_signal<MUX>      srf_wr_from;
     sc_signal<uint64_t> srf_in[WORD_64B], srf_out[WORD_64B];
+    swar_rep_cache<SRF_ENTRIES> srf_rep;    // Replicated SRF scalars, memoized by value
     // Mask RF
     sc_signal<uint>     mrf_rd_addr, mrf_wr_addr;
     sc_signal<bool>     mrf_wr_en;
@@ -145,12 +161,14 @@ public:
     reg<WORD_64B> *R[REG_NUM];
 #if VWR_DRAM_CLK > 1
     vwr_multicycle<VWR_BITS, WORD_BITS, DRAM_BITS> *vwreg[VWR_NUM];
+#elif PACKED_VWR
+    vwr_packed<VWR_BITS, WORD_BITS, WORDS_PER_VWR> *vwreg[VWR_NUM];
 #else
     vwr<VWR_BITS, WORD_BITS, WORDS_PER_VWR> *vwreg[VWR_NUM];
 #endif
 #if DUAL_BANK_INTERFACE
     tristate_buffer<DRAM_BITS> *even_buf, *odd_buf;
-#else
+#elif !FAST_BUSES
     tristate_buffer<DRAM_BITS> *dram_buf;
 #endif
 
@@ -299,7 +317,12 @@ public:
         ts->output_en(ts_out_en);
         ts->out_start(ts_out_start);
         ts->mode(ts_mode);
+#if FAST_BUSES
+        ts->vww_in(ts_in);
+        ts->vww_out(ts_out);
+#else
         ts->vww_inout(ts_inout);
+#endif
 #endif
 
         ib_macro = new rf_twoport<uint64_t, IB_ENTRIES>("Macroinstruction_buffer");
@@ -372,7 +395,11 @@ public:
         }
 #else
         for (i=0; i<VWR_NUM; i++) {
+#if PACKED_VWR
+            vwreg[i] = new vwr_packed<VWR_BITS, WORD_BITS, WORDS_PER_VWR>(sc_gen_unique_name("VWR"));
+#else
             vwreg[i] = new vwr<VWR_BITS, WORD_BITS, WORDS_PER_VWR>(sc_gen_unique_name("VWR"));
+#endif
             vwreg[i]->clk(clk);
             vwreg[i]->rst(rst);
             vwreg[i]->enable(vwr_enable[i]);
@@ -381,8 +408,15 @@ public:
             vwreg[i]->mask_en(vwr_mask_en[i]);
             vwreg[i]->mask(vwr_mask[i]);
             vwreg[i]->d_nm(vwr_d_nm[i]);
+#if FAST_BUSES
+            vwreg[i]->lport_in(vwr_in[i]);
+            vwreg[i]->lport_out(vwr_out[i]);
+            vwreg[i]->sport_in(vwr_muxed_in[i]);
+            vwreg[i]->sport_out(vwr_muxed_out[i]);
+#else
             vwreg[i]->lport(vwr_inout[i]);
             vwreg[i]->sport(vwr_muxed[i]);
+#endif
         }
 #endif
 
@@ -402,7 +436,7 @@ public:
         even_buf->output(even_bus);
         odd_buf->output(odd_bus);
 
-#else   // DUAL_BANK_INTERFACE
+#elif !FAST_BUSES
 
         dram_buf = new tristate_buffer<DRAM_BITS>("DRAM_tristate_buffer");
         dram_buf->input(to_dram);
@@ -412,7 +446,11 @@ public:
 #endif  // DUAL_BANK_INTERFACE
 
         SC_METHOD(comb_method);
+#if FAST_BUSES
+        sensitive << ts_shf_from << ts_out;
+#else
         sensitive << ts_shf_from << ts_inout;
+#endif
         sensitive << srf_wr_from << mrf_wr_from << csdrf_wr_from;
         sensitive << sa_op1_from << sa_op2_from << pm_op1_from << pm_op2_from;
         for (int i=0; i<MASK_64B; i++)
@@ -424,12 +462,18 @@ public:
             for (int j=0; j<WORD_64B; j++)
                 sensitive << R_out[i][j];
         }
+#if FAST_BUSES
+        for (int i=0; i<VWR_NUM; i++)
+            sensitive << vwr_wr_nrd[i] << vwr_from[i] << vwr_out[i] << vwr_muxed_out[i];
+        sensitive << dram_in << dram_from << dram_out_en;
+#else
         for (int i=0; i<VWR_NUM; i++)
             sensitive << vwr_wr_nrd[i] << vwr_from[i] << vwr_inout[i] << vwr_muxed[i];
 #if DUAL_BANK_INTERFACE
         sensitive << even_bus << odd_bus;
 #else
         sensitive << dram_bus << dram_from;
+#endif
 #endif
 
         SC_METHOD(adaptation_method);
@@ -0,0 +1,393 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Word-parallel (SWAR) versions of the subword operations of the datapath,
+ * working on words packed in 64-bit lanes (bit 0 is the LSB of lane 0).
+ * Simulation only.
+ *
+ */
+
+#ifndef SRC_SWAR_OPS_H_
+#define SRC_SWAR_OPS_H_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "defs.h"
+#include "opcodes.h"
+#include "log2.h"
+#include "packed_bits.h"
+
+#define SWAR_SIZES      (uint(SWSIZE::B24) + 1)             // Subword sizes with precomputed masks
+#define SWAR_MAX_SHIFT  (MAX(SA_MAX_SHIFT, PM_MAX_SHIFT))   // Largest shift with precomputed masks
+#define SWAR_MAX_START  (2*(MASK_BITS/3))                   // Start positions of the repacker (3-bit subwords)
+
+// Masks of the subwords of a word, for each subword size
+struct swar_masks {
+    uint64_t gb[MASK_BITS+1][WORD_64B];                         // Guard bit (MSB) of each subword, by size in bits
+    uint64_t top[SWAR_SIZES][SWAR_MAX_SHIFT+1][WORD_64B];       // n MSBs of each subword, by SWSIZE
+
+    swar_masks() {
+        uint size, n, i;
+
+        memset(gb, 0, sizeof(gb));
+        memset(top, 0, sizeof(top));
+        for (size = 1; size <= MASK_BITS; size++) {
+            for (i = 0; i < WORD_BITS/size; i++) {
+                packed_set(gb[size], (i+1)*size-1, 1, 1);
+            }
+        }
+        for (uint s = 1; s < SWAR_SIZES; s++) {
+            size = swsize_to_uint(SWSIZE(s));
+            for (i = 0; i < WORD_BITS/size; i++) {
+                for (n = 1; n <= SWAR_MAX_SHIFT && n <= size; n++) {
+                    packed_set(top[s][n], (i+1)*size-n, n, ~(uint64_t) 0);
+                }
+            }
+        }
+    }
+
+    static const swar_masks &get() {
+        static const swar_masks masks;
+        return masks;
+    }
+};
+
+// Guard bit mask of the subwords of a size. Built in aux if not precomputed
+inline const uint64_t *swar_guard_mask(uint size, uint64_t *aux) {
+    if (size <= MASK_BITS) {
+        return swar_masks::get().gb[size];
+    }
+    memset(aux, 0, WORD_64B*sizeof(uint64_t));
+    for (uint i = 0; i < WORD_BITS/size; i++) {
+        packed_set(aux, (i+1)*size-1, 1, 1);
+    }
+    return aux;
+}
+
+// Add-with-carry builtin of the compiler, if it has it
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_addcll)
+#define SWAR_HAS_ADDC   1
+#endif
+#endif
+#ifndef SWAR_HAS_ADDC
+#define SWAR_HAS_ADDC   0
+#endif
+
+// Addition of two 64-bit limbs with carry in and out
+inline uint64_t swar_addc(uint64_t a, uint64_t b, uint64_t carry_in, uint64_t *carry_out) {
+#if SWAR_HAS_ADDC
+    unsigned long long c;
+    uint64_t sum = __builtin_addcll(a, b, carry_in, &c);
+    *carry_out = c;
+    return sum;
+#else
+    unsigned long long s1, s2;
+    bool c1 = __builtin_uaddll_overflow(a, b, &s1);
+    bool c2 = __builtin_uaddll_overflow(s1, carry_in, &s2);
+    *carry_out = c1 | c2;
+    return s2;
+#endif
+}
+
+#undef SWAR_HAS_ADDC
+
+// Right shift of the whole word, keeping the guard bit of each subword and
+// extending its sign. Same as the bit-by-bit right_shifter: bypass if shift is
+// zero or above max_shift, plain shift of the word if size is zero
+inline void swar_right_shift(const uint64_t *in, uint64_t *out, uint shift, uint size, uint max_shift) {
+    uint i, n, s;
+    uint64_t sign, sign_low, sub, borrow, diff, fill;
+
+    // If shift is zero or too large, bypass shifter
+    if (shift > max_shift || shift == 0) {
+        memmove(out, in, WORD_64B*sizeof(uint64_t));
+        return;
+    }
+
+    s = uint(uint_to_swsize(size));
+    if (shift >= 64 || (size && (!s || shift > SWAR_MAX_SHIFT))) {
+        // Not covered by the masks, shift each subword separately
+        uint64_t in_aux[WORD_64B];
+        memcpy(in_aux, in, sizeof(in_aux));
+        memset(out, 0, WORD_64B*sizeof(uint64_t));
+        if (shift < WORD_64B*64) {
+            packed_copy(out, 0, in_aux, shift, WORD_64B*64 - shift);
+        }
+        for (i = 0; size && size <= 64 && i < WORD_BITS/size; i++) {
+            uint64_t sw = packed_get(in_aux, i*size, size);
+            uint64_t sw_sign = (sw >> (size-1)) & 1;
+            n = (shift < size) ? shift : size;
+            sw = (shift < size) ? (sw >> shift) : 0;
+            packed_set(out, i*size, size, sw | (sw_sign ? packed_lsb_mask(n) << (size-n) : 0));
+        }
+        return;
+    }
+
+    // Shift of the word, then the n MSBs of each subword are replaced by its sign
+    const swar_masks &masks = swar_masks::get();
+    n = (shift < size) ? shift : size;
+    const uint64_t *msb = masks.gb[size];
+    const uint64_t *top = masks.top[s][n];
+    borrow = 0;
+    for (i = 0; i < WORD_64B; i++) {
+        uint64_t next = (i + 1 < WORD_64B) ? in[i+1] : 0;
+        uint64_t shifted = (in[i] >> shift) | (next << (64 - shift));
+        if (!size) {
+            out[i] = shifted;
+            continue;
+        }
+        // Sign bits spread down to n bits as (sign - (sign >> (n-1))) | sign.
+        // There is no borrow between subwords, only between lanes of the same subword
+        uint64_t next_sign = (i + 1 < WORD_64B) ? next & msb[i+1] : 0;
+        sign = in[i] & msb[i];
+        sign_low = (n > 1) ? (sign >> (n-1)) | (next_sign << (65 - n)) : sign;
+        sub = sign_low + borrow;
+        diff = sign - sub;
+        borrow = (sign < sub) || (sub < sign_low);
+        fill = (n > 1) ? diff | sign : sign;
+        out[i] = (shifted & ~top[i]) | (fill & top[i]);
+    }
+}
+
+// Same as and_or_guardbits: set (OR) or clear (AND) the guard bits of the subwords
+inline void swar_and_or_guardbits(const uint64_t *in, uint64_t *out, uint size, bool gb_to_one) {
+    uint64_t mask_aux[WORD_64B];
+
+    if (!size) {
+        memmove(out, in, WORD_64B*sizeof(uint64_t));
+        return;
+    }
+    const uint64_t *mask = swar_guard_mask(size, mask_aux);
+    for (uint i = 0; i < WORD_64B; i++) {
+        out[i] = gb_to_one ? in[i] | mask[i] : in[i] & ~mask[i];
+    }
+}
+
+// Same as add_sub: addition of the (negated if selected) operands along the
+// whole word, with a carry in if any is negated
+inline void swar_add_sub(const uint64_t *op1, const uint64_t *op2, uint64_t *out, bool neg_op1, bool neg_op2) {
+    uint64_t carry = neg_op1 || neg_op2;
+    uint64_t inv1 = neg_op1 ? ~(uint64_t) 0 : 0;
+    uint64_t inv2 = neg_op2 ? ~(uint64_t) 0 : 0;
+
+    for (uint i = 0; i < WORD_64B; i++) {
+        out[i] = swar_addc(op1[i] ^ inv1, op2[i] ^ inv2, carry, &carry);
+    }
+}
+
+// Same as adder_msb_set: the guard bit of each subword is op1 ^ op2 ^ add_out,
+// with the operands before the guard bits were set (negated if selected)
+inline void swar_msb_set(const uint64_t *op1, const uint64_t *op2, const uint64_t *add_out, uint64_t *out,
+                         uint size, bool neg_op1, bool neg_op2) {
+    uint64_t mask_aux[WORD_64B];
+    uint64_t inv = (neg_op1 != neg_op2) ? ~(uint64_t) 0 : 0;
+
+    if (!size) {
+        memmove(out, add_out, WORD_64B*sizeof(uint64_t));
+        return;
+    }
+    const uint64_t *mask = swar_guard_mask(size, mask_aux);
+    for (uint i = 0; i < WORD_64B; i++) {
+        out[i] = (add_out[i] & ~mask[i]) | ((op1[i] ^ op2[i] ^ inv ^ add_out[i]) & mask[i]);
+    }
+}
+
+// Guard bits, addition/subtraction and MSB setting of the Shift & Add stage
+// (SA_AND_OR) in a single pass over the limbs. out may alias op1 or op2
+inline void swar_sa_add(const uint64_t *op1, const uint64_t *op2, uint64_t *out, uint size, bool neg_op1, bool neg_op2) {
+    uint64_t mask_aux[WORD_64B];
+    uint64_t a, b, sum;
+    uint64_t carry = neg_op1 || neg_op2;
+    uint64_t inv1 = neg_op1 ? ~(uint64_t) 0 : 0;
+    uint64_t inv2 = neg_op2 ? ~(uint64_t) 0 : 0;
+
+    if (!size) {
+        swar_add_sub(op1, op2, out, neg_op1, neg_op2);
+        return;
+    }
+    const uint64_t *mask = swar_guard_mask(size, mask_aux);
+    bool gb_to_one1 = !neg_op1 && neg_op2;
+    bool gb_to_one2 = neg_op1 && !neg_op2;
+    for (uint i = 0; i < WORD_64B; i++) {
+        a = gb_to_one1 ? op1[i] | mask[i] : op1[i] & ~mask[i];
+        b = gb_to_one2 ? op2[i] | mask[i] : op2[i] & ~mask[i];
+        sum = swar_addc(a ^ inv1, b ^ inv2, carry, &carry);
+        out[i] = (sum & ~mask[i]) | ((op1[i] ^ inv1 ^ op2[i] ^ inv2 ^ sum) & mask[i]);
+    }
+}
+
+// Move of a repacking plan: len bits of w1 (src = 0) or w2 (src = 1) starting at
+// src_lo, to bit dst_b of output lane dst_w. A move never crosses an output lane
+typedef struct swar_repack_move {
+    uint16_t src_lo;
+    uint8_t src, len;
+    uint8_t dst_w, dst_b;
+} swar_repack_move;
+
+// Builds the plan of the data_pack repacking of w1+w2, as subword moves merged
+// when contiguous in both input and output. Assumes the repacking is legal
+inline void swar_repack_plan(uint in_size, uint out_size, uint in_start, std::vector<swar_repack_move> &plan) {
+    uint i, j, in_idx, src_lo, dst_lo, len, chunk;
+    bool nw1_w2;
+
+    plan.clear();
+#if !LOCAL_REPACK   // Shuffling along the whole word
+    const uint chunks = 1, chunk_bits = WORD_BITS;
+#else               // Shuffling within MASK_BITS chunks
+    const uint chunks = MASK_PER_WORD, chunk_bits = MASK_BITS;
+#endif
+    for (i = 0; i < chunks; i++) {
+        for (j = 0; j < chunk_bits/out_size; j++) {
+            in_idx = (j + in_start) % (2*(chunk_bits/in_size));
+            nw1_w2 = in_idx >= chunk_bits/in_size;
+            if (nw1_w2)
+                in_idx -= chunk_bits/in_size;
+
+            if (in_size < out_size) {   // Left aligned, without sign extension
+                src_lo = i*chunk_bits + in_idx*in_size;
+                dst_lo = i*chunk_bits + (j+1)*out_size - in_size;
+                len = in_size;
+            } else {                    // Keeping MSBs
+                src_lo = i*chunk_bits + (in_idx+1)*in_size - out_size;
+                dst_lo = i*chunk_bits + j*out_size;
+                len = out_size;
+            }
+
+            while (len) {
+                chunk = (len < 64 - dst_lo % 64) ? len : 64 - dst_lo % 64;
+                swar_repack_move *last = plan.empty() ? NULL : &plan.back();
+                if (last && last->src == nw1_w2 && last->src_lo + last->len == src_lo
+                        && last->dst_w == dst_lo / 64 && last->dst_b + last->len == dst_lo % 64) {
+                    last->len += chunk;
+                } else {
+                    plan.push_back({uint16_t(src_lo), uint8_t(nw1_w2), uint8_t(chunk), uint8_t(dst_lo / 64), uint8_t(dst_lo % 64)});
+                }
+                src_lo += chunk;
+                dst_lo += chunk;
+                len -= chunk;
+            }
+        }
+    }
+}
+
+// Repacking plans for every pair of subword sizes and start position
+struct swar_repack_plans {
+    std::vector<swar_repack_move> plan[SWAR_SIZES][SWAR_SIZES][SWAR_MAX_START];
+
+    swar_repack_plans() {
+        uint in_size, out_size;
+
+        for (uint si = 1; si < SWAR_SIZES; si++) {
+            in_size = swsize_to_uint(SWSIZE(si));
+            for (uint so = 1; so < SWAR_SIZES; so++) {
+                out_size = swsize_to_uint(SWSIZE(so));
+                for (uint st = 0; st < 2*(MASK_BITS/in_size) && st < SWAR_MAX_START; st++) {
+                    swar_repack_plan(in_size, out_size, st, plan[si][so][st]);
+                }
+            }
+        }
+    }
+
+    static const swar_repack_plans &get() {
+        static const swar_repack_plans plans;
+        return plans;
+    }
+};
+
+// Same as data_pack: repack the subwords of w1+w2 starting at in_start, with the
+// precomputed plan of the sizes. Output is w1 if the repacking is not legal.
+// out must not alias w1 or w2
+inline void swar_repack(const uint64_t *w1, const uint64_t *w2, uint64_t *out, uint in_size, uint out_size, uint in_start) {
+    uint si, so;
+    const uint64_t *src[2] = {w1, w2};
+
+    // Check if the packing is "legal" (otherwise, output same as w1)
+    if (in_size > MASK_BITS || out_size > MASK_BITS || in_size == 0 || out_size == 0
+        || in_start >= 2*(MASK_BITS/in_size)) {
+        memmove(out, w1, WORD_64B*sizeof(uint64_t));
+        return;
+    }
+
+    si = uint(uint_to_swsize(in_size));
+    so = uint(uint_to_swsize(out_size));
+    std::vector<swar_repack_move> local_plan;
+    const std::vector<swar_repack_move> *plan;
+    if (si && so && in_start < SWAR_MAX_START) {
+        plan = &swar_repack_plans::get().plan[si][so][in_start];
+    } else {    // Sizes without precomputed plans
+        swar_repack_plan(in_size, out_size, in_start, local_plan);
+        plan = &local_plan;
+    }
+
+    memset(out, 0, WORD_64B*sizeof(uint64_t));
+    for (const swar_repack_move &m : *plan) {
+        out[m.dst_w] |= packed_get(src[m.src], m.src_lo, m.len) << m.dst_b;
+    }
+}
+
+// Same as tile_shuffler: each word of the VWR is a word of the input, rotated
+// right <out_start> words (SHIFT), word <out_start> (BROADCAST), or each word
+// repeated <out_start> times (REPEAT, the words after the last full group keep
+// the input). The bits above the last word are cleared. out must not alias in
+inline void swar_tile_shuffle(const uint64_t *in, uint64_t *out, TS_MODE mode, uint out_start) {
+    uint i, src, repeated = out_start ? (WORDS_PER_VWR / out_start) * out_start : 0;
+
+    for (i = 0; i < WORDS_PER_VWR; i++) {
+        switch (mode) {
+            case TS_MODE::SHIFT:        src = (i + out_start) % WORDS_PER_VWR;          break;
+            case TS_MODE::BROADCAST:    src = out_start;                                break;
+            case TS_MODE::REPEAT:       src = (i < repeated) ? i / out_start : i;       break;
+            default:                    src = i;                                        break;
+        }
+        packed_copy(out, i*WORD_BITS, in, src*WORD_BITS, WORD_BITS);
+    }
+    packed_clear(out, WORDS_PER_VWR*WORD_BITS, VWR_64B*64);
+}
+
+// Same as mask_unit: replicate the MASK_BITS LSBs of a mask (or SRF scalar) over
+// the MASK_PER_WORD chunks of a word, the bits above are cleared
+inline void swar_replicate_mask(const uint64_t *mask, uint64_t *out) {
+    uint64_t m = packed_get(mask, 0, MASK_BITS);
+    memset(out, 0, WORD_64B*sizeof(uint64_t));
+    for (uint i = 0; i < MASK_PER_WORD; i++) {
+        packed_set(out, i*MASK_BITS, MASK_BITS, m);
+    }
+}
+
+// Memoized replicas of the masks (or SRF scalars) read from an RF. A replica is
+// looked up by the raw value it was built from, so a write to the RF needs no
+// invalidation and the read address is not needed. The slot is picked from the
+// raw value, sized for the entries of the RF
+template<uint slots>
+class swar_rep_cache {
+public:
+    swar_rep_cache() {
+        memset(valid, 0, sizeof(valid));
+    }
+
+    // Replicated form of the raw mask
+    const uint64_t *get(const uint64_t *raw) {
+        uint64_t h = 0;
+        for (uint i = 0; i < MASK_64B; i++) {
+            h = (h ^ raw[i]) * 0x9e3779b97f4a7c15ULL;
+        }
+        uint s = (h >> 32) % slots;
+        if (!valid[s] || memcmp(tag[s], raw, sizeof(tag[s]))) {
+            memcpy(tag[s], raw, sizeof(tag[s]));
+            swar_replicate_mask(raw, rep[s]);
+            valid[s] = true;
+        }
+        return rep[s];
+    }
+
+private:
+    uint64_t    tag[slots][MASK_64B];   // Raw masks the replicas were built from
+    uint64_t    rep[slots][WORD_64B];   // Replicated masks
+    bool        valid[slots];
+};
+
+#endif /* SRC_SWAR_OPS_H_ */
@@ -0,0 +1,70 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Contents of the DRAM banks of a pseudo-channel, for the pch testbench. Only
+ * the rows that are touched are kept, each one as a page with all its columns,
+ * allocated and cleared on its first write. Each column holds the VWR_BITS that
+ * every core moves with a single RD or WR in All-Banks mode.
+ *
+ */
+
+#ifndef SRC_TB_BANK_STORAGE_H_
+#define SRC_TB_BANK_STORAGE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+#include "../defs.h"
+
+class bank_storage {
+public:
+
+    // 64-bit words of a column, VWR_64B per core
+    static const uint32_t COL_WORDS = CORES_PER_PCH * VWR_64B;
+
+    // Column of an allocated page, NULL if the row was never written
+    const uint64_t *read(uint64_t bank, uint64_t row, uint64_t col) const {
+        auto page = pages.find(page_key(bank, row));
+        return (page == pages.end()) ? NULL : page->second.get() + col * COL_WORDS;
+    }
+
+    // Column to be written, allocating its page if needed
+    uint64_t *write(uint64_t bank, uint64_t row, uint64_t col) {
+        std::unique_ptr<uint64_t[]> &page = pages[page_key(bank, row)];
+        if (!page) {
+            page.reset(new uint64_t[PAGE_WORDS]);
+            memset(page.get(), 0, PAGE_WORDS * sizeof(uint64_t));
+        }
+        return page.get() + col * COL_WORDS;
+    }
+
+    // Copies a whole column, COL_WORDS words
+    void store(uint64_t bank, uint64_t row, uint64_t col, const uint64_t *words) {
+        memcpy(write(bank, row, col), words, COL_WORDS * sizeof(uint64_t));
+    }
+
+    // Bank (with its rank and bank group), row and column of an address
+    static void locate(uint64_t addr, uint64_t &bank, uint64_t &row, uint64_t &col) {
+        bank = (addr >> RA_END) & ((1 << (RANK_BITS + BG_BITS + BANK_BITS)) - 1);
+        row = (addr >> RO_END) & ((1 << ROW_BITS) - 1);
+        col = (addr >> CO_END) & ((1 << COL_BITS) - 1);
+    }
+
+    size_t allocated_pages() const {
+        return pages.size();
+    }
+
+private:
+    static const uint32_t PAGE_WORDS = (1 << COL_BITS) * COL_WORDS;
+
+    std::unordered_map<uint64_t, std::unique_ptr<uint64_t[]> > pages;     // By row and bank (with its rank and bank group)
+
+    static uint64_t page_key(uint64_t bank, uint64_t row) {
+        return (row << (RANK_BITS + BG_BITS + BANK_BITS)) | bank;
+    }
+};
+
+#endif /* SRC_TB_BANK_STORAGE_H_ */
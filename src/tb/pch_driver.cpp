@@ -13,29 +13,80 @@
 #include <fstream>
 #include <string>
 #include <deque>
+#include <memory>
 #include <assert.h>
 
 using namespace std;
 
+uint pch_driver::running = 0;
+
+#if ENGINE_CHECK
+// Compares a word sent to the banks with the one from the standalone engine
+static void engine_check(uint64_t (*engineOut)[VWR_64B], int core, int word, uint64_t bank2out, int curCycle, uint64_t *mismatches) {
+    uint64_t engineWord = engineOut[core][word];
+
+    if (64*(word+1)-1 >= VWR_BITS) {
+        engineWord &= packed_lsb_mask(VWR_BITS - 64*word);
+    }
+    if (engineWord != bank2out) {
+        if (*mismatches < 16) {
+            cout << "Engine mismatch at cycle " << dec << curCycle << ", core " << core << ", word " << word
+                    << ": " << showbase << hex << bank2out << " vs " << engineWord << endl;
+        }
+        (*mismatches)++;
+    }
+}
+#endif
+
 void pch_driver::driver_thread() {
 
-    int i, j, curCycle;
+    int i, j, curCycle, nextCycle;
     sc_uint<64> bank2out;
     bool lastCmd, bankRead, bankWrite;
+    bool cmdDriven, busDriven;      // Signals to be returned to default values in the next cycle
+#if CYCLE_SIM
+    sc_time settle = SC_ZERO_TIME;  // Waited in the current cycle for the PUs to drive the buses
+#endif
 
     sc_uint<ADDR_TOTAL_BITS> addrAux;
 
     // Values for reading from input
-    string line;
+    trace_view cmd;
+    unique_ptr<trace_source> fileSource;        // Only when reading the .sci file, text or binary
+    trace_source *input = source;
     int readCycle = 0;
     unsigned long int readAddr;
+    bool readWr;
     dq_type data2DQ;
-    uint64_t dataAux, data2bankAux;
-    sc_biguint<DRAM_BITS> bankAux, data2bank;
+    uint64_t data2bankAux;
+#if FAST_BUSES
+    packed_bv<DRAM_BITS> bankAux, allzs;                // Two-valued buses are zero when not driven
+    packed_bv<DRAM_BITS> data2bank[CORES_PER_PCH];      // Sent to the banks in the cycle after the RD
+#else
+    sc_biguint<DRAM_BITS> bankAux;
     sc_lv<DRAM_BITS> allzs(SC_LOGIC_Z);
-    string readCmd;
-    deque<uint64_t> readData;
-    deque<sc_biguint<DRAM_BITS> > data2bankBuffer;
+    sc_biguint<DRAM_BITS> data2bank[CORES_PER_PCH];     // Sent to the banks in the cycle after the RD
+#endif
+    const uint64_t *readData;       // Payload, owned by the input until the next command is read
+    uint32_t readWords, readIdx;
+    const uint64_t *rdWords;        // Sent to the banks by a PIM RD, VWR_64B words per core
+
+#if BANK_MODEL
+    // Bank contents, read by the RDs without payload
+    bank_storage banks;
+    uint64_t bank, row, col;
+    uint64_t bankCol[bank_storage::COL_WORDS];      // Column written by a PIM WR
+#endif
+
+#if ENGINE_CHECK
+    // Standalone engine run in lockstep, checked on every PIM WR
+    softsimd_engine_pch *engine = new softsimd_engine_pch;
+    engine_cmd engineCmd;
+    uint64_t (*engineOut)[VWR_64B] = new uint64_t[CORES_PER_PCH][VWR_64B];
+    uint64_t (*engineBank)[VWR_64B] = new uint64_t[CORES_PER_PCH][VWR_64B];
+    bool engineBankNext;
+    uint64_t engineMismatches = 0;
+#endif
 
 
     // Initial reset
@@ -43,6 +94,7 @@ void pch_driver::driver_thread() {
     lastCmd = false;
     bankRead = false;
     bankWrite = false;
+    cmdDriven = busDriven = false;
     rst->write(false);
     RD->write(false);
     WR->write(false);
@@ -57,6 +109,8 @@ void pch_driver::driver_thread() {
 #if DUAL_BANK_INTERFACE
         even_buses[i]->write(allzs);
         odd_buses[i]->write(allzs);
+#elif FAST_BUSES
+        dram_in[i]->write(allzs);
 #else
         dram_buses[i]->write(allzs);
 #endif
@@ -69,45 +123,81 @@ void pch_driver::driver_thread() {
     wait(CLK_PERIOD / 2 + 1, RESOLUTION);
     curCycle++;
 
-    // Open input file
-    string fi = "INPUTS_DIR/SystemC/" + filename + ".sci0";		// Input file name, located in pim-cores folder
-    ifstream input;
-    input.open(fi);
-    if (!input.is_open())   {
-        cout << "Error when opening input file " << fi << endl;
-        sc_stop();
-        return;
+    // Open input file, unless the commands come from another stage
+    string fi = "INPUTS_DIR/SystemC/" + filename + ".sci" + to_string(channel);	// Input file name, located in pim-cores folder
+    if (!input) {
+        fileSource = open_trace_source(fi, true);
+        if (!fileSource)   {
+            cout << "Error when opening input file " << fi << endl;
+            stats.error = true;
+            sc_stop();
+            return;
+        }
+        input = fileSource.get();
+    }
+
+#if BANK_MODEL
+    // Initial bank contents, if any: WR commands of a raw trace, with a column of
+    // payload each. Only the ones of this pseudo-channel are kept
+    string fm = "INPUTS_DIR/SystemC/" + filename + ".mem";
+    unique_ptr<trace_source> preload = open_trace_source(fm, false);
+    if (preload) {
+        while (preload->next_view(cmd)) {
+            if (((cmd.addr >> CH_END) & ((1 << CHANNEL_BITS) - 1)) != channel) {
+                continue;
+            }
+            if (!cmd.wr || cmd.words != bank_storage::COL_WORDS) {
+                cout << "Error, preload commands must be WR with " << bank_storage::COL_WORDS << " words in " << fm << endl;
+                preload->error = true;
+                break;
+            }
+            bank_storage::locate(cmd.addr, bank, row, col);
+            banks.store(bank, row, col, cmd.data);
+        }
+        if (preload->error) {
+            cout << "Error when reading preload file " << fm << endl;
+            stats.error = true;
+            sc_stop();
+            return;
+        }
     }
+#endif
 
     // Open output file
-    string fo = "INPUTS_DIR/results/" + filename + ".results";	// Output file name, located in pim-cores folder
+    string fo = "INPUTS_DIR/results/" + pch_channel_name(filename, channel) + ".results";	// Output file name, located in pim-cores folder
     ofstream output;
     output.open(fo);
     if (!output.is_open())   {
         cout << "Error when opening output file" << fo << endl;
+        stats.error = true;
         sc_stop();
         return;
     }
 
-    // Read first line
-    if (getline(input, line)) {
+    // Read first command
+    if (input->next_view(cmd)) {
 
-        // Read elements from a line in the input file
-        istringstream iss(line);
-        readData.clear();
-        if (!(iss >> dec >> readCycle >> hex >> readAddr >> readCmd)) {
-            cout << "Error when reading input" << endl;
-            sc_stop();
-            return;
-        }
-        while (iss >> hex >> dataAux) {
-            readData.push_back(dataAux);
-        }
+        readCycle = cmd.cycle;
+        readAddr = cmd.addr;
+        readWr = cmd.wr;
+        readData = cmd.data;
+        readWords = cmd.words;
+        readIdx = 0;
 
-    } else {
-        cout << "No lines in the input file" << endl;
+    } else if (input->error) {
+        cout << "Error when reading input" << endl;
+        stats.error = true;
         sc_stop();
         return;
+    } else {
+        // A pseudo-channel without commands is idle for the whole simulation
+        cout << "No commands in the input of channel " << channel << endl;
+        output.close();
+        stats.end_cycle = curCycle;
+        if (--running == 0) {
+            sc_stop();
+        }
+        return;
     }
 
     // cout << "MACRO_DST_BITS = " << MACRO_DST_BITS << endl;
@@ -136,48 +226,63 @@ void pch_driver::driver_thread() {
     // cout << "PM_DST_N_BITS = " << PM_DST_N_BITS << endl;
     // cout << "PM_FIELDS_BITS = " << PM_FIELDS_BITS << endl;
 
+    // The mode does not change during the simulation
+    AB_mode->write(true);
+    pim_mode->write(true);
+
     // Simulation loop
     while (1) {
 
 //    	cout << "Cycle " << dec << curCycle << endl;
 
-        // Default values
-        RD->write(false);
-        WR->write(false);
-        ACT->write(false);
-        AB_mode->write(true);
-        pim_mode->write(true);
-        DQ->write(0);
-        for (i = 0; i < CORES_PER_PCH; i++) {
+        // Default values, only for the signals driven in the previous cycle
+        if (cmdDriven) {
+            RD->write(false);
+            WR->write(false);
+            DQ->write(0);
+            cmdDriven = false;
+        }
+        if (busDriven) {
+            for (i = 0; i < CORES_PER_PCH; i++) {
 #if DUAL_BANK_INTERFACE
-            even_buses[i]->write(allzs);
-            odd_buses[i]->write(allzs);
+                even_buses[i]->write(allzs);
+                odd_buses[i]->write(allzs);
+#elif FAST_BUSES
+                dram_in[i]->write(allzs);
 #else
-            dram_buses[i]->write(allzs);
+                dram_buses[i]->write(allzs);
 #endif
+            }
+            busDriven = false;
         }
+#if ENGINE_CHECK
+        engineCmd = {false, false, 0, 0, 0};
+        engineBankNext = false;
+#endif
 
         // Fill the banks' sense amplifiers with the corresponding data
         if (bankRead) {
 #if DUAL_BANK_INTERFACE
             if (addrAux.range(BA_END, BA_END)) {
                 for (i = 0; i < CORES_PER_PCH; i++) {
-                    odd_buses[i]->write(data2bankBuffer.front());
-                    data2bankBuffer.pop_front();
+                    odd_buses[i]->write(data2bank[i]);
                 }
             } else {
                 for (i = 0; i < CORES_PER_PCH; i++) {
-                    even_buses[i]->write(data2bankBuffer.front());
-                    data2bankBuffer.pop_front();
+                    even_buses[i]->write(data2bank[i]);
                 }
             }
 #else
             for (i = 0; i < CORES_PER_PCH; i++) {
-                dram_buses[i]->write(data2bankBuffer.front());
-                data2bankBuffer.pop_front();
+#if FAST_BUSES
+                dram_in[i]->write(data2bank[i]);
+#else
+                dram_buses[i]->write(data2bank[i]);
+#endif
             }
 #endif
             bankRead = false;
+            busDriven = true;
         }
 
         // Execute necessary command at the right time and read next line
@@ -193,7 +298,7 @@ void pch_driver::driver_thread() {
                 // Writing to the RFs
 
                 // Check command
-                if (!readCmd.compare("RD")) {
+                if (!readWr) {
 
                     // If writing to RFs and RD, do nothing
                     cout << "Warning: RF writing mode but saw a RD command"
@@ -202,45 +307,79 @@ void pch_driver::driver_thread() {
                 } else {    // NOTE Only works if <= 64 bits, otherwise need to implement DQcycle count
 
                     // If writing to RFs and WR, format data to DQ
-                        assert(readData.size() == 1);   // Check it is only one piece of data
-                        data2DQ = readData.front();
-                        readData.pop_front();
+                        assert(readWords == 1);         // Check it is only one piece of data
+                        data2DQ = readData[readIdx++];
                         WR->write(true);
                         bank_addr->write(addrAux.range(BA_STA, BA_END));
                         row_addr->write(addrAux.range(RO_STA, RO_END));
                         col_addr->write(addrAux.range(CO_STA, CO_END));
                         DQ->write(data2DQ);
+                        cmdDriven = true;
+                        stats.rf_writes++;
+#if ENGINE_CHECK
+                        engineCmd = {false, true, (uint) addrAux.range(RO_STA, RO_END).to_uint(), (uint) addrAux.range(CO_STA, CO_END).to_uint(), data2DQ};
+#endif
                 }
 
             } else {
                 // PIM execution
 
                 // Check command
-                if (!readCmd.compare("RD")) {
+                if (!readWr) {
 
                     RD->write(true);
                     bank_addr->write(addrAux.range(BA_STA, BA_END));
                     row_addr->write(addrAux.range(RO_STA, RO_END));
                     col_addr->write(addrAux.range(CO_STA, CO_END));
+                    cmdDriven = true;
+                    stats.pim_reads++;
+#if ENGINE_CHECK
+                    engineCmd = {true, false, (uint) addrAux.range(RO_STA, RO_END).to_uint(), (uint) addrAux.range(CO_STA, CO_END).to_uint(), 0};
+#endif
 
                     // If PIM execution and RD with input data, send to the corresponding bank buses in the next cycle
-                    if (!readData.empty()){
-                        assert(readData.size() == VWR_64B*CORES_PER_PCH);// Check if there are enough pieces of data
+                    rdWords = NULL;
+#if BANK_MODEL
+                    bank_storage::locate(readAddr, bank, row, col);
+#endif
+                    if (readIdx < readWords){
+                        assert(readWords == VWR_64B*CORES_PER_PCH);// Check if there are enough pieces of data
+                        rdWords = readData + readIdx;
+                        readIdx += VWR_64B*CORES_PER_PCH;
+#if BANK_MODEL
+                        banks.store(bank, row, col, rdWords);   // The payload is kept as the bank contents
+                    } else {
+                        rdWords = banks.read(bank, row, col);   // Preloaded or written before, if the row was touched
+#endif
+                    }
 
+                    if (rdWords) {
                         for (i = 0; i < CORES_PER_PCH; i++) {
                             for (j = 0; j < VWR_64B; j++){
-                                data2bankAux = readData.front();
-                                readData.pop_front();
+                                data2bankAux = rdWords[i*VWR_64B + j];
+#if ENGINE_CHECK
+                                engineBank[i][j] = (64*(j+1)-1 < VWR_BITS) ? data2bankAux : data2bankAux & packed_lsb_mask(VWR_BITS - 64*j);
+#endif
+#if FAST_BUSES
+                                if (64*(j+1)-1 < VWR_BITS) {
+                                    data2bank[i][j] = data2bankAux;
+                                } else {
+                                    data2bank[i][j] = data2bankAux & packed_lsb_mask(VWR_BITS - 64*j);
+                                }
+#else
                                 if (64*(j+1)-1 < VWR_BITS) {
-                                    data2bank.range(64*(j+1)-1,64*j) = data2bankAux;
+                                    data2bank[i].range(64*(j+1)-1,64*j) = data2bankAux;
                                 } else {
-                                    data2bank.range(VWR_BITS-1,64*j) = data2bankAux;
+                                    data2bank[i].range(VWR_BITS-1,64*j) = data2bankAux;
                                 }
+#endif
                             }
-                            data2bankBuffer.push_back(data2bank);
                         }
 
                         bankRead = true;
+#if ENGINE_CHECK
+                        engineBankNext = true;
+#endif
                     }
 
                 } else {
@@ -251,6 +390,11 @@ void pch_driver::driver_thread() {
                     row_addr->write(addrAux.range(RO_STA, RO_END));
                     col_addr->write(addrAux.range(CO_STA, CO_END));
                     bankWrite = true;
+                    cmdDriven = true;
+                    stats.pim_writes++;
+#if ENGINE_CHECK
+                    engineCmd = {false, true, (uint) addrAux.range(RO_STA, RO_END).to_uint(), (uint) addrAux.range(CO_STA, CO_END).to_uint(), 0};
+#endif
 
                     // Write address here because it will be overwritten later with the next cmd
                     output << showbase << dec << curCycle << "\t" << hex << readAddr << "\t";
@@ -258,22 +402,21 @@ void pch_driver::driver_thread() {
                 }
             }
 
-            // Read next line
-            if (getline(input, line)) {
+            // Read next command
+            if (input->next_view(cmd)) {
 
-                // Read elements from a line in the input file
-                istringstream iss(line);
-                readData.clear();
-                if (!(iss >> dec >> readCycle >> hex >> readAddr >> readCmd)) {
-                    cout << "Error when reading input" << endl;
-                    break;
-                }
-                while (iss >> hex >> dataAux) {
-                    readData.push_back(dataAux);
-                }
+                readCycle = cmd.cycle;
+                readAddr = cmd.addr;
+                readWr = cmd.wr;
+                readData = cmd.data;
+                readWords = cmd.words;
+                readIdx = 0;
 
+            } else if (input->error) {
+                cout << "Error when reading input" << endl;
+                stats.error = true;
+                break;
             } else {// Wait for enough time for the last instruction to be completed
-                input.close();
                 lastCmd = true;
                 readCycle += (5);
             }
@@ -284,9 +427,24 @@ void pch_driver::driver_thread() {
             break;
         }
 
+#if ENGINE_CHECK
+        // Same cycle in the engine, bank data read now is pushed in the next one
+        engine->idle_until(curCycle);
+        engine->step(engineCmd, engineOut);
+        if (engineBankNext) {
+            memcpy(engine->bank_data, engineBank, sizeof(engine->bank_data));
+            engine->bank_pending = true;
+        }
+#endif
+
         if (bankWrite) {
+#if CYCLE_SIM
+            settle = sc_time(CLK_PERIOD / 2 + 1, RESOLUTION);   // The PUs are evaluated in the falling edge
+            wait(settle);
+#else
             for (i = 0; i < 20; i++)    // More than one deltas are needed
                 wait(0, RESOLUTION);    // We need to wait for a delta to solve the bank buses
+#endif
 #if DUAL_BANK_INTERFACE
             if (addrAux.range(BA_END, BA_END)) {
                 for (i = 0; i < CORES_PER_PCH; i++) {
@@ -298,6 +456,9 @@ void pch_driver::driver_thread() {
                             bank2out = bankAux.range(VWR_BITS-1,64*j);
                         }
                         output << showbase << hex << bank2out << "\t";
+#if BANK_MODEL
+                        bankCol[i*VWR_64B + j] = bank2out;
+#endif
                     }
                 }
             } else {
@@ -310,9 +471,30 @@ void pch_driver::driver_thread() {
                             bank2out = bankAux.range(VWR_BITS-1,64*j);
                         }
                         output << showbase << hex << bank2out << "\t";
+#if BANK_MODEL
+                        bankCol[i*VWR_64B + j] = bank2out;
+#endif
                     }
                 }
             }
+#elif FAST_BUSES
+            for (i = 0; i < CORES_PER_PCH; i++) {
+                bankAux = dram_out[i]->read();
+                for (j = 0; j < VWR_64B; j++) {
+                    if (64*(j+1)-1 < VWR_BITS) {
+                        bank2out = bankAux[j];
+                    } else {
+                        bank2out = bankAux[j] & packed_lsb_mask(VWR_BITS - 64*j);
+                    }
+                    output << showbase << hex << bank2out << "\t";
+#if BANK_MODEL
+                    bankCol[i*VWR_64B + j] = bank2out;
+#endif
+#if ENGINE_CHECK
+                    engine_check(engineOut, i, j, bank2out, curCycle, &engineMismatches);
+#endif
+                }
+            }
 #else
             for (i = 0; i < CORES_PER_PCH; i++) {
                 bankAux = dram_buses[i]->read();
@@ -323,21 +505,54 @@ void pch_driver::driver_thread() {
                         bank2out = bankAux.range(VWR_BITS-1,64*j);
                     }
                     output << showbase << hex << bank2out << "\t";
+#if BANK_MODEL
+                    bankCol[i*VWR_64B + j] = bank2out;
+#endif
+#if ENGINE_CHECK
+                    engine_check(engineOut, i, j, bank2out, curCycle, &engineMismatches);
+#endif
                 }
             }
 #endif
             output << endl;
+#if BANK_MODEL
+            // What the cores wrote is read back by later RDs of the same column
+            bank_storage::locate(addrAux.to_uint64(), bank, row, col);
+            banks.store(bank, row, col, bankCol);
+#endif
             bankWrite = false;
         }
 
-        wait(CLK_PERIOD, RESOLUTION);
-        curCycle++;
+        // Sleep until the next command, unless something driven now has to be released
+        nextCycle = curCycle + 1;
+        if (!cmdDriven && !busDriven && !bankRead && readCycle > nextCycle) {
+            nextCycle = readCycle;
+        }
+#if CYCLE_SIM
+        wait(sc_time(CLK_PERIOD, RESOLUTION) * (nextCycle - curCycle) - settle);
+        settle = SC_ZERO_TIME;
+#else
+        wait(sc_time(CLK_PERIOD, RESOLUTION) * (nextCycle - curCycle));
+#endif
+        curCycle = nextCycle;
     }
 
-    cout << "Simulation finished at cycle " << dec << curCycle << endl;
+    stats.end_cycle = curCycle;
+#if ENGINE_CHECK
+    cout << "Engine check (channel " << dec << channel << "): " << dec << engineMismatches << " mismatching words, engine finished at cycle "
+            << engine->finish() << " (" << engine->eval_cycles << " evaluated)" << endl;
+    delete[] engineOut;
+    delete[] engineBank;
+    delete engine;
+#endif
+#if BANK_MODEL
+    cout << "Bank model (channel " << dec << channel << "): " << banks.allocated_pages() << " rows allocated" << endl;
+#endif
 
-    // Stop simulation
-    sc_stop();
+    // Stop simulation when all pseudo-channels are done
+    if (--running == 0) {
+        sc_stop();
+    }
 
 }
 
@@ -1,6 +1,28 @@
 #include "systemc.h"
+#include <string>
 
 #include "../cnm_base.h"
+#include "../trace_cmd.h"
+#if ENGINE_CHECK
+#include "../softsimd_engine.h"
+#endif
+#if BANK_MODEL
+#include "bank_storage.h"
+#endif
+
+// Name of the files of a pseudo-channel, channel 0 keeps the name of the trace
+inline std::string pch_channel_name(const std::string &filename, uint channel) {
+    return channel ? filename + "_ch" + std::to_string(channel) : filename;
+}
+
+// Statistics of the commands issued to a pseudo-channel
+typedef struct pch_stats {
+    uint64_t end_cycle;     // Cycle at which the pseudo-channel finished
+    uint64_t rf_writes;     // WR commands to the RFs
+    uint64_t pim_reads;     // PIM RD commands
+    uint64_t pim_writes;    // PIM WR commands
+    bool error;             // The trace could not be simulated
+} pch_stats;
 
 class pch_driver: public sc_module {
 public:
@@ -44,6 +66,9 @@ public:
 #if DUAL_BANK_INTERFACE
     sc_inout_rv<DRAM_BITS>      even_buses[CORES_PER_PCH];  // Direct data in/out to the even banks
     sc_inout_rv<DRAM_BITS>      odd_buses[CORES_PER_PCH];   // Direct data in/out to the odd banks
+#elif FAST_BUSES
+    sc_out<packed_bv<DRAM_BITS> >   dram_in[CORES_PER_PCH];     // Direct data from the banks
+    sc_in<packed_bv<DRAM_BITS> >    dram_out[CORES_PER_PCH];    // Direct data to the banks
 #else
     sc_inout_rv<DRAM_BITS>      dram_buses[CORES_PER_PCH];  // Direct data in/out to the banks
 #endif
@@ -51,8 +76,16 @@ public:
 #endif  // MIXED_SIM
 
     std::string filename;
+    uint channel;               // Pseudo-channel, reads the .sci<channel> stream of the trace
+    trace_source *source;       // Commands of the pseudo-channel, the .sci<channel> file if NULL
+    pch_stats stats;
+    static uint running;        // Drivers still issuing commands, the last one stops the simulation
+
     SC_HAS_PROCESS(pch_driver);
-    pch_driver(sc_module_name name_, std::string filename_) : sc_module(name_), filename(filename_) {
+    pch_driver(sc_module_name name_, std::string filename_, uint channel_ = 0, trace_source *source_ = NULL) : sc_module(name_),
+            filename(filename_), channel(channel_), source(source_) {
+        stats = {0, 0, 0, 0, false};
+        running++;
         SC_THREAD(driver_thread);
     }
 
@@ -17,6 +17,8 @@
 
 using namespace std;
 
+uint pch_driver::running = 0;
+
 void pch_driver::driver_thread() {
 
     int i, j, curCycle;
@@ -3,7 +3,9 @@
 
 #include "pch_driver.h"
 #include "pch_monitor.h"
+#include <iomanip>
 #include <string>
+#include <vector>
 
 #if MIXED_SIM
 #include "../softsimd_wrapped.h"
@@ -225,6 +227,177 @@ SC_MODULE(top) {
 
 };
 
+#elif !MIXED_SIM
+
+// One pseudo-channel: its PUs, the driver fed with the .sci<channel> stream of
+// the trace (or with the given source), the monitor and the signals between them
+class pch_channel: public sc_module {
+public:
+
+    sc_in_clk                       clk;
+
+    sc_signal<bool>                 rst;
+    sc_signal<bool>                 RD;							// DRAM read command
+    sc_signal<bool>                 WR;							// DRAM write command
+    sc_signal<bool>                 ACT;						// DRAM activate command
+//    sc_signal<bool>					RSTB;						//
+    sc_signal<bool>                 AB_mode;		            // Signals if the All-Banks mode is enabled
+    sc_signal<bool>                 pim_mode;			        // Signals if the PIM mode is enabled
+    sc_signal<sc_uint<BANK_BITS> >  bank_addr;			        // Address of the bank
+    sc_signal<sc_uint<ROW_BITS> >   row_addr;			        // Address of the bank row
+    sc_signal<sc_uint<COL_BITS> >   col_addr;		            // Address of the bank column
+    sc_signal<uint64_t>             DQ;	                        // Data input from DRAM controller (output makes no sense
+#if DUAL_BANK_INTERFACE
+    sc_signal_rv<DRAM_BITS>         even_buses[CORES_PER_PCH];  // Direct data in/out to the even banks
+    sc_signal_rv<DRAM_BITS>         odd_buses[CORES_PER_PCH];   // Direct data in/out to the odd banks
+#elif FAST_BUSES
+    sc_signal<packed_bv<DRAM_BITS> >    dram_in[CORES_PER_PCH];     // Direct data from the banks
+    sc_signal<packed_bv<DRAM_BITS> >    dram_out[CORES_PER_PCH];    // Direct data to the banks
+#else
+    sc_signal_rv<DRAM_BITS>         dram_buses[CORES_PER_PCH];  // Direct data in/out to the banks
+#endif
+
+    imc_pch dut;
+    pch_driver driver;
+    pch_monitor monitor;
+
+#if (RECORDING || EN_MODEL)
+    pch_channel(sc_module_name name, std::string filename, uint channel, trace_source *source = NULL) : sc_module(name),
+            dut("IMCCoreUnderTest", pch_channel_name(filename, channel)),
+            driver("Driver", filename, channel, source), monitor("Monitor")
+#else
+    pch_channel(sc_module_name name, std::string filename, uint channel, trace_source *source = NULL) : sc_module(name),
+            dut("IMCCoreUnderTest"), driver("Driver", filename, channel, source), monitor("Monitor")
+#endif
+    {
+        uint i;
+
+        dut.clk(clk);
+        dut.rst(rst);
+        dut.RD(RD);
+        dut.WR(WR);
+        dut.ACT(ACT);
+    //    dut.RSTB(RSTB);
+        dut.AB_mode(AB_mode);
+        dut.pim_mode(pim_mode);
+        dut.bank_addr(bank_addr);
+        dut.row_addr(row_addr);
+        dut.col_addr(col_addr);
+        dut.DQ(DQ);
+        for (i = 0; i < CORES_PER_PCH; i++) {
+#if DUAL_BANK_INTERFACE
+            dut.even_buses[i](even_buses[i]);
+            dut.odd_buses[i](odd_buses[i]);
+#elif FAST_BUSES
+            dut.dram_in[i](dram_in[i]);
+            dut.dram_out[i](dram_out[i]);
+#else
+            dut.dram_buses[i](dram_buses[i]);
+#endif
+        }
+
+        driver.rst(rst);
+        driver.RD(RD);
+        driver.WR(WR);
+        driver.ACT(ACT);
+    //    driver.RSTB(RSTB);
+        driver.AB_mode(AB_mode);
+        driver.pim_mode(pim_mode);
+        driver.bank_addr(bank_addr);
+        driver.row_addr(row_addr);
+        driver.col_addr(col_addr);
+        driver.DQ(DQ);
+        for (i = 0; i < CORES_PER_PCH; i++) {
+#if DUAL_BANK_INTERFACE
+            driver.even_buses[i](even_buses[i]);
+            driver.odd_buses[i](odd_buses[i]);
+#elif FAST_BUSES
+            driver.dram_in[i](dram_in[i]);
+            driver.dram_out[i](dram_out[i]);
+#else
+            driver.dram_buses[i](dram_buses[i]);
+#endif
+        }
+
+        monitor.clk(clk);
+        monitor.rst(rst);
+        monitor.RD(RD);
+        monitor.WR(WR);
+        monitor.ACT(ACT);
+    //    monitor.RSTB(RSTB);
+        monitor.AB_mode(AB_mode);
+        monitor.pim_mode(pim_mode);
+        monitor.bank_addr(bank_addr);
+        monitor.row_addr(row_addr);
+        monitor.col_addr(col_addr);
+        monitor.DQ(DQ);
+        for (i = 0; i < CORES_PER_PCH; i++) {
+#if DUAL_BANK_INTERFACE
+            monitor.even_buses[i](even_buses[i]);
+            monitor.odd_buses[i](odd_buses[i]);
+#elif FAST_BUSES
+            monitor.dram_in[i](dram_in[i]);
+            monitor.dram_out[i](dram_out[i]);
+#else
+            monitor.dram_buses[i](dram_buses[i]);
+#endif
+        }
+    }
+};
+
+// Prints the statistics of every pseudo-channel and of all of them, and writes
+// the energy counts. Returns the exit code of the simulation
+inline int pch_report(const std::vector<pch_channel *> &channels, const std::string &filename) {
+    // Per-channel and aggregate statistics
+    uint numChannels = channels.size();
+    uint c;
+    uint64_t maxCycle = 0, sumCycle = 0;
+    pch_stats total = {0, 0, 0, 0, false};
+    for (c = 0; c < numChannels; c++) {
+        const pch_stats &stats = channels[c]->driver.stats;
+        maxCycle = MAX(maxCycle, stats.end_cycle);
+        sumCycle += stats.end_cycle;
+        total.rf_writes += stats.rf_writes;
+        total.pim_reads += stats.pim_reads;
+        total.pim_writes += stats.pim_writes;
+        total.error |= stats.error;
+    }
+    std::cout << "Simulation finished at cycle " << std::dec << maxCycle << std::endl;
+    if (numChannels > 1) {
+        std::cout << "Channel\tEnd cycle\tRF WR\tPIM RD\tPIM WR" << std::endl;
+        for (c = 0; c < numChannels; c++) {
+            const pch_stats &stats = channels[c]->driver.stats;
+            std::cout << c << "\t" << stats.end_cycle << "\t" << stats.rf_writes << "\t"
+                    << stats.pim_reads << "\t" << stats.pim_writes << (stats.error ? "\tERROR" : "") << std::endl;
+        }
+        std::cout << "All\t" << maxCycle << "\t" << total.rf_writes << "\t" << total.pim_reads << "\t" << total.pim_writes << std::endl;
+        std::cout << "Load imbalance (max/mean end cycle): " << std::fixed << std::setprecision(3)
+                << (sumCycle ? double(maxCycle) * numChannels / sumCycle : 1.0) << std::endl;
+    }
+
+#if EN_MODEL
+    // Counts per PU, and summed per pseudo-channel and over all of them
+    std::vector<control_unit *> chCus, allCus;
+    uint i;
+    for (c = 0; c < numChannels; c++) {
+        chCus.clear();
+        for (i = 0; i < CORES_PER_PCH; i++) {
+            channels[c]->dut.imc_cores[i]->cu->write_energy_stats();
+            chCus.push_back(channels[c]->dut.imc_cores[i]->cu);
+        }
+        if (numChannels > 1) {
+            control_unit::write_energy_stats(chCus, pch_channel_name(filename, c) + "_pch");
+        }
+        allCus.insert(allCus.end(), chCus.begin(), chCus.end());
+    }
+    if (numChannels > 1) {
+        control_unit::write_energy_stats(allCus, filename + "_all");
+    }
+#endif
+
+    return total.error ? 1 : 0;
+}
+
 #endif
 
 #endif /* PCH_MAIN_H_ */
@@ -46,6 +46,9 @@ SC_MODULE(pch_monitor) {
 #if DUAL_BANK_INTERFACE
     sc_inout_rv<DRAM_BITS>      even_buses[CORES_PER_PCH];  // Direct data in/out to the even banks
     sc_inout_rv<DRAM_BITS>      odd_buses[CORES_PER_PCH];   // Direct data in/out to the odd banks
+#elif FAST_BUSES
+    sc_in<packed_bv<DRAM_BITS> >    dram_in[CORES_PER_PCH];     // Direct data from the banks
+    sc_in<packed_bv<DRAM_BITS> >    dram_out[CORES_PER_PCH];    // Direct data to the banks
 #else
     sc_inout_rv<DRAM_BITS>      dram_buses[CORES_PER_PCH];  // Direct data in/out to the banks
 #endif
@@ -0,0 +1,42 @@
+#include "rshift_driver.h"
+
+#include <random>
+
+void rshift_driver::driver_thread() {
+
+    uint clk_period = 10;
+    uint i, j, k, m;
+    uint64_t word_aux;
+    const uint sizes[] = {0, 3, 4, 6, 8, 12, 16, 24};
+    std::mt19937_64 rng(1);
+
+    // Initialization
+    for (i = 0; i < WORD_64B; i++) {
+        input[i]->write(0);
+    }
+    shift->write(0);
+    size->write(0);
+
+    // Test every subword size and shift (also above the maximum) with different inputs:
+    // all ones, all signs set, alternating bits and random words
+    for (k = 0; k < 16; k++) {
+        for (i = 0; i < WORD_64B; i++) {
+            switch (k) {
+                case 0:     word_aux = ~(uint64_t) 0;           break;
+                case 1:     word_aux = 0x8000800080008000;      break;
+                case 2:     word_aux = 0xAAAAAAAAAAAAAAAA;      break;
+                default:    word_aux = rng();                   break;
+            }
+            input[i]->write(word_aux);
+        }
+        for (j = 0; j < sizeof(sizes)/sizeof(sizes[0]); j++) {
+            size->write(sizes[j]);
+            for (m = 0; m <= PM_MAX_SHIFT + 1; m++) {
+                shift->write(m);
+                wait(clk_period, SC_NS);
+            }
+        }
+    }
+
+    sc_stop();
+}
@@ -0,0 +1,16 @@
+#include "systemc.h"
+
+#include "../cnm_base.h"
+
+SC_MODULE(rshift_driver) {
+
+    sc_out<uint64_t>        input[WORD_64B];
+    sc_out<uint>            shift;
+    sc_out<uint>            size;
+
+    SC_CTOR(rshift_driver) {
+        SC_THREAD(driver_thread);
+    }
+
+    void driver_thread();
+};
@@ -0,0 +1,51 @@
+#include "rshift_driver.h"
+#include "rshift_monitor.h"
+#include "../right_shifter.h"
+#include <string>
+
+// Checks the word-parallel right shifters against the bit-by-bit implementation
+int sc_main(int argc, char *argv[]) {
+    sc_signal<uint64_t>     input[WORD_64B];
+    sc_signal<uint>         shift;
+    sc_signal<uint>         size;
+    sc_signal<uint64_t>     SA_out[WORD_64B];
+    sc_signal<uint64_t>     PM_out[WORD_64B];
+
+    right_shifter<SA_MAX_SHIFT> saut("SAShifterUnderTest");
+    saut.shift(shift);
+    saut.size(size);
+    for (uint i = 0; i < WORD_64B; i++) {
+        saut.input[i](input[i]);
+        saut.output[i](SA_out[i]);
+    }
+
+    right_shifter<PM_MAX_SHIFT> pmut("PMShifterUnderTest");
+    pmut.shift(shift);
+    pmut.size(size);
+    for (uint i = 0; i < WORD_64B; i++) {
+        pmut.input[i](input[i]);
+        pmut.output[i](PM_out[i]);
+    }
+
+    rshift_driver driver("Driver");
+    driver.shift(shift);
+    driver.size(size);
+    for (uint i = 0; i < WORD_64B; i++) {
+        driver.input[i](input[i]);
+    }
+
+    rshift_monitor monitor("Monitor");
+    monitor.shift(shift);
+    monitor.size(size);
+    for (uint i = 0; i < WORD_64B; i++) {
+        monitor.input[i](input[i]);
+        monitor.SA_out[i](SA_out[i]);
+        monitor.PM_out[i](PM_out[i]);
+    }
+
+    sc_start();
+
+    cout << "Right shifter test: " << monitor.checks << " vectors, " << monitor.errors << " mismatches" << endl;
+
+    return monitor.errors != 0;
+}
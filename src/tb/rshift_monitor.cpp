@@ -0,0 +1,34 @@
+#include "rshift_monitor.h"
+#include "../right_shifter.h"
+
+// Compares the output of the shifters with the bit-by-bit reference implementation
+void rshift_monitor::monitor_thread() {
+
+    uint i;
+    uint64_t in_aux[WORD_64B], sa_ref[WORD_64B], pm_ref[WORD_64B];
+    bool sa_ok, pm_ok;
+
+    wait(5, SC_NS);     // Sample in the middle of each test vector
+
+    while(1) {
+        for (i = 0; i < WORD_64B; i++) {
+            in_aux[i] = input[i];
+        }
+        right_shifter<SA_MAX_SHIFT>::bv_right_shift(in_aux, sa_ref, shift, size);
+        right_shifter<PM_MAX_SHIFT>::bv_right_shift(in_aux, pm_ref, shift, size);
+
+        sa_ok = pm_ok = true;
+        for (i = 0; i < WORD_64B; i++) {
+            sa_ok &= SA_out[i] == sa_ref[i];
+            pm_ok &= PM_out[i] == pm_ref[i];
+        }
+        if (!sa_ok || !pm_ok) {
+            cout << "Mismatch at time " << sc_time_stamp() << " size " << size << " shift " << shift
+                 << (sa_ok ? "" : " (S&A shifter)") << (pm_ok ? "" : " (P&M shifter)") << endl;
+            errors++;
+        }
+        checks++;
+
+        wait(10, SC_NS);
+    }
+}
@@ -0,0 +1,20 @@
+#include "systemc"
+
+#include "../cnm_base.h"
+
+SC_MODULE(rshift_monitor) {
+    sc_in<uint64_t>     input[WORD_64B];
+    sc_in<uint>         shift;
+    sc_in<uint>         size;
+    sc_in<uint64_t>     SA_out[WORD_64B];   // Output of the S&A shifter
+    sc_in<uint64_t>     PM_out[WORD_64B];   // Output of the P&M shifter
+
+    uint checks, errors;
+
+    SC_CTOR(rshift_monitor) {
+        SC_THREAD(monitor_thread);
+        checks = errors = 0;
+    }
+
+    void monitor_thread();
+};
@@ -7,10 +7,20 @@
  */
 
 #include "tile_shuffler.h"
+#include "swar_ops.h"
+
+#ifndef __SYNTHESIS__
 
 void tile_shuffler::clk_thread() {
+#if !FAST_BUSES
+    sc_lv<VWR_BITS> out_aux;
+#endif
+
     // Reset behavior
-    shuffle_reg = 0;
+    shuffle_reg = packed_bv<VWR_BITS>();
+#if !FAST_BUSES
+    shuffle_out = 0;
+#endif
 
     wait();
 
@@ -18,69 +28,62 @@ void tile_shuffler::clk_thread() {
     while (1) {
         if (input_en) {
             shuffle_reg = shuffle_nxt;
+#if !FAST_BUSES
+            packed_to_lv(shuffle_nxt.read().w, out_aux, VWR_BITS);
+            shuffle_out = out_aux;
+#endif
         }
         wait();
     }
 }
 
-#ifndef __SYNTHESIS__
-
 void tile_shuffler::comb_method() {
 
-    uint intervals;
-    sc_lv<WORD_BITS> broadcast;
-    sc_lv<VWR_BITS> repeat;
-    sc_lv<VWR_BITS> shift_r('0'), shift_l('0');
+    packed_bv<VWR_BITS> shuffle_aux;
+#if !FAST_BUSES
+    packed_bv<VWR_BITS> in_aux;
+#endif
 
     TS_MODE mode_aux = mode;
     mode_test = (uint) mode_aux;
 
-    shuffle_nxt = shuffle_reg;
-
     if (input_en->read() && out_start->read() < WORDS_PER_VWR) {
 
-        // Get only the relevant bits from the vww bus
-        vww_aux = vww_inout;
-        in_aux = 0;
-        in_aux.range(WORDS_PER_VWR*WORD_BITS-1, 0) = vww_aux.range(WORDS_PER_VWR*WORD_BITS-1, 0);
-
-        shuffle_aux = in_aux;
+        // Shuffle whole words of the vww bus, the bits above the last word are cleared
+#if FAST_BUSES
+        swar_tile_shuffle(vww_in->read().w, shuffle_aux.w, mode_aux, out_start->read());
+#else
+        lv_to_packed(vww_inout->read(), in_aux.w, VWR_BITS);
+        swar_tile_shuffle(in_aux.w, shuffle_aux.w, mode_aux, out_start->read());
+#endif
 
-        switch (mode) {
-
-            case TS_MODE::NOP:  // Input = output
-            break;
-            case TS_MODE::SHIFT:    // Circular shift right <out_start> words the VWR
-                shift_r = in_aux >> (out_start*WORD_BITS);
-                shift_l = in_aux << ((WORDS_PER_VWR - out_start)*WORD_BITS);
-                shuffle_aux = shift_r | shift_l;
-            break;
-            case TS_MODE::BROADCAST:    // Broadcast <out_start> word to fill the VWR
-                broadcast = in_aux.range((out_start+1)*WORD_BITS-1, out_start*WORD_BITS);
-                for (uint i = 0; i < WORDS_PER_VWR; i++) {
-                    shuffle_aux.range((i+1)*WORD_BITS-1, i*WORD_BITS) = broadcast;
-                }
-            break;
-            case TS_MODE::REPEAT:   // Repeat each word <out_start> times until filling the VWR
-                intervals = WORDS_PER_VWR / out_start;
-                for (uint i = 0; i < intervals; i++) {
-                    repeat = in_aux.range((i+1)*WORD_BITS-1, i*WORD_BITS);
-                    for (uint j = 0; j < out_start; j++) {
-                        shuffle_aux.range(i*out_start*WORD_BITS+(j+1)*WORD_BITS-1, i*out_start*WORD_BITS+j*WORD_BITS) = repeat;
-                    }
-                }
-            break;
-            default:    // Input = output
-            break;
-        }
-
-        // Write out through the tristate buffer
         shuffle_nxt = shuffle_aux;
     }
 }
 
+#if FAST_BUSES
+void tile_shuffler::output_method() {
+    vww_out->write(output_en->read() ? shuffle_reg.read() : packed_bv<VWR_BITS>());
+}
+#endif
+
 #else   // __SYNTHESIS__
 
+void tile_shuffler::clk_thread() {
+    // Reset behavior
+    shuffle_reg = 0;
+
+    wait();
+
+    // Clocked behavior
+    while (1) {
+        if (input_en) {
+            shuffle_reg = shuffle_nxt;
+        }
+        wait();
+    }
+}
+
 void tile_shuffler::comb_method() {
 
     uint intervals;
@@ -26,33 +26,54 @@ public:
     sc_in<bool>             output_en;  // Enables the output after shuffling words
     sc_in<uint>             out_start;  // Start location for the words shuffled out
     sc_in<TS_MODE>          mode;       // Selects shuffling mode
+#if FAST_BUSES
+    sc_in<packed_bv<VWR_BITS> >     vww_in;     // Input very wide word
+    sc_out<packed_bv<VWR_BITS> >    vww_out;    // Output very wide word (zero when not enabled)
+#else
     sc_inout_rv<VWR_BITS>   vww_inout;  // I/O very wide word
+#endif
 
     // Internal signals and variables
-    sc_signal<sc_lv<VWR_BITS> > shuffle_reg, shuffle_nxt;
-    sc_lv<VWR_BITS>             in_aux, out_aux, shuffle_aux, vww_aux;
-    sc_signal<uint>             mode_test;
+    sc_signal<packed_bv<VWR_BITS> > shuffle_reg, shuffle_nxt;   // Shuffled words, packed
+#if !FAST_BUSES
+    sc_signal<sc_lv<VWR_BITS> >     shuffle_out;    // Shuffled words, driven to the tristate buffer
+#endif
+    sc_signal<uint>                 mode_test;
 
     // Internal modules
+#if !FAST_BUSES
     tristate_buffer<VWR_BITS> *inout_buffer;
+#endif
 
     SC_CTOR(tile_shuffler) {
 
+#if FAST_BUSES
+        SC_METHOD(output_method);
+        sensitive << shuffle_reg << output_en;
+#else
         inout_buffer = new tristate_buffer<VWR_BITS>("Inout_buffer");
-        inout_buffer->input(shuffle_reg);
+        inout_buffer->input(shuffle_out);
         inout_buffer->enable(output_en);
         inout_buffer->output(vww_inout);
+#endif
 
         SC_THREAD(clk_thread);
         sensitive << clk.pos();
         async_reset_signal_is(rst, false);
 
         SC_METHOD(comb_method);
+#if FAST_BUSES
+        sensitive << input_en << out_start << mode << vww_in;
+#else
         sensitive << input_en << out_start << mode << vww_inout;
+#endif
     }
 
     void clk_thread();  // Registers the results of tile shuffling
     void comb_method(); // Performs removal or addition of guard bits according to the flags
+#if FAST_BUSES
+    void output_method();   // Drives the output word when enabled
+#endif
 
 #else   // __SYNTHESIS__
 
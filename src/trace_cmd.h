@@ -0,0 +1,479 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Commands of the raw sequence (.seq) and SystemC input (.sci) traces, and the
+ * sources that hand them out one by one. The tools and the pch_driver can read
+ * them from a file or from another stage running in the same process.
+ * Trace files are text, or binary records with the payload as raw 64-bit words.
+ * Files are memory-mapped when possible, and the payload of binary ones is
+ * handed out as a view into the mapping, without copies. A stage running in
+ * another thread hands them over through a bounded queue.
+ *
+ */
+
+#ifndef SRC_TRACE_CMD_H_
+#define SRC_TRACE_CMD_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Format of raw traces:        Address R/W     Data
+// Format of SystemC input:     Cycle   Address R/W     Data
+typedef struct trace_cmd {
+    uint64_t cycle;                 // Issue cycle, only in SystemC inputs
+    uint64_t addr;                  // DRAM address
+    bool wr;                        // WR command, RD otherwise
+    std::vector<uint64_t> data;     // Payload, 64-bit words
+} trace_cmd;
+
+// Command whose payload is owned by the source that handed it out, valid until its next command
+typedef struct trace_view {
+    uint64_t cycle;                 // Issue cycle, only in SystemC inputs
+    uint64_t addr;                  // DRAM address
+    bool wr;                        // WR command, RD otherwise
+    const uint64_t *data;           // Payload, 64-bit words
+    uint32_t words;                 // Words in the payload
+} trace_view;
+
+// Reads a trace line, with the cycle first if timed. Returns false if it is not valid
+inline bool parse_trace_cmd(const std::string &line, bool timed, trace_cmd &cmd) {
+    std::istringstream iss(line);
+    std::string cmdString;
+    uint64_t dataAux;
+
+    cmd.cycle = 0;
+    cmd.data.clear();
+    if (timed && !(iss >> std::dec >> cmd.cycle)) {
+        return false;
+    }
+    if (!(iss >> std::hex >> cmd.addr >> cmdString)) {
+        return false;
+    }
+    cmd.wr = cmdString.compare("RD");
+    while (iss >> std::hex >> dataAux) {
+        cmd.data.push_back(dataAux);
+    }
+    return true;
+}
+
+// Writes a trace line in the same format as nmc_assembler (raw) and ramulator2sc (timed)
+inline void write_trace_cmd(std::ostream &os, const trace_cmd &cmd, bool timed) {
+    if (timed) {
+        os << std::showbase << std::dec << cmd.cycle << "\t" << std::hex << cmd.addr << "\t" << (cmd.wr ? "WR" : "RD") << "\t";
+        for (uint64_t data : cmd.data) {
+            os << std::hex << data << "\t";
+        }
+    } else {
+        os << std::showbase << std::hex << cmd.addr << "\t" << (cmd.wr ? "WR" : "RD");
+        for (uint64_t data : cmd.data) {
+            os << "\t" << std::showbase << std::hex << data;
+        }
+    }
+    os << std::endl;
+}
+
+// Binary traces: a header and one record per command, each followed by its payload.
+// Fields are in host byte order (little-endian in the supported hosts)
+#define TRACE_BIN_MAGIC     "SDTR"
+#define TRACE_BIN_VERSION   1
+
+typedef struct trace_bin_header {
+    char magic[4];          // TRACE_BIN_MAGIC
+    uint32_t version;       // TRACE_BIN_VERSION
+    uint32_t timed;         // 1 if the records have the issue cycle (SystemC input)
+    uint32_t reserved;
+} trace_bin_header;
+
+typedef struct trace_bin_record {
+    uint64_t cycle;         // Issue cycle, 0 in raw traces
+    uint64_t addr;          // DRAM address
+    uint32_t wr;            // 1 for WR commands, 0 for RD
+    uint32_t words;         // 64-bit payload words after the record
+} trace_bin_record;
+
+// Writes the commands of a trace in text or binary format
+class trace_writer {
+public:
+    trace_writer(std::ostream &os_, bool timed_, bool binary_) : os(os_), timed(timed_), binary(binary_) {
+        if (binary) {
+            trace_bin_header header = {{0}, TRACE_BIN_VERSION, timed, 0};
+            memcpy(header.magic, TRACE_BIN_MAGIC, sizeof(header.magic));
+            os.write((const char *) &header, sizeof(header));
+        }
+    }
+
+    void write(const trace_cmd &cmd) {
+        if (binary) {
+            trace_bin_record record = {cmd.cycle, cmd.addr, cmd.wr, (uint32_t) cmd.data.size()};
+            os.write((const char *) &record, sizeof(record));
+            os.write((const char *) cmd.data.data(), cmd.data.size() * sizeof(uint64_t));
+        } else {
+            write_trace_cmd(os, cmd, timed);
+        }
+    }
+
+private:
+    std::ostream &os;
+    bool timed;             // Text lines start with the cycle
+    bool binary;
+};
+
+// Removes --binary from the arguments of a tool. Returns true if it was given
+inline bool take_binary_flag(int &argc, const char **argv) {
+    int i, kept = 1;
+    bool binary = false;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--binary")) {
+            binary = true;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    return binary;
+}
+
+// Hands out the commands of a trace in order
+class trace_source {
+public:
+    bool error = false;     // Set if a command could not be read
+
+    virtual ~trace_source() {}
+    // Returns false at the end of the trace or on error
+    virtual bool next(trace_cmd &cmd) = 0;
+
+    // Same as next, without handing over the payload. By default it is kept in
+    // a command reused for the whole trace
+    virtual bool next_view(trace_view &view) {
+        if (!next(viewCmd)) {
+            return false;
+        }
+        view = {viewCmd.cycle, viewCmd.addr, viewCmd.wr, viewCmd.data.data(), (uint32_t) viewCmd.data.size()};
+        return true;
+    }
+
+protected:
+    trace_cmd viewCmd;
+};
+
+// Commands read from a text trace file
+class text_trace_source: public trace_source {
+public:
+    text_trace_source(const std::string &filename, bool timed_) : input(filename), timed(timed_) {}
+
+    bool is_open() const {
+        return input.is_open();
+    }
+
+    bool next(trace_cmd &cmd) override {
+        if (error || !getline(input, line)) {
+            return false;
+        }
+        error = !parse_trace_cmd(line, timed, cmd);
+        return !error;
+    }
+
+private:
+    std::ifstream input;
+    std::string line;
+    bool timed;             // Lines start with the cycle
+};
+
+// Commands read from a binary trace file. A raw sequence is not accepted where
+// a timed trace is expected, nor the opposite
+class bin_trace_source: public trace_source {
+public:
+    bin_trace_source(const std::string &filename, bool timed) : input(filename, std::ios::binary) {
+        trace_bin_header header;
+        if (input.read((char *) &header, sizeof(header)) && !memcmp(header.magic, TRACE_BIN_MAGIC, sizeof(header.magic))
+                && header.version == TRACE_BIN_VERSION) {
+            valid = ((header.timed != 0) == timed);
+        }
+    }
+
+    // The file was opened and has a header of the supported version and kind
+    bool is_valid() const {
+        return valid;
+    }
+
+    bool next(trace_cmd &cmd) override {
+        trace_bin_record record;
+        if (error || !input.read((char *) &record, sizeof(record))) {
+            error = error || input.gcount();    // A partial record is an error, no record is the end
+            return false;
+        }
+        cmd.cycle = record.cycle;
+        cmd.addr = record.addr;
+        cmd.wr = record.wr;
+        cmd.data.resize(record.words);
+        error = !input.read((char *) cmd.data.data(), record.words * sizeof(uint64_t));
+        return !error;
+    }
+
+private:
+    std::ifstream input;
+    bool valid = false;
+};
+
+// Commands of a memory-mapped trace file in either format. Binary payloads are
+// views into the mapping, text ones are parsed into a buffer reused for the whole trace
+class mapped_trace_source: public trace_source {
+public:
+    mapped_trace_source(const std::string &filename, bool timed_) : timed(timed_) {
+        struct stat st;
+        int fd = open(filename.c_str(), O_RDONLY);
+
+        if (fd < 0) {
+            return;
+        }
+        if (!fstat(fd, &st) && S_ISREG(st.st_mode)) {
+            size = st.st_size;
+            if (!size) {
+                mapped = true;      // Nothing to map, no commands
+            } else {
+                base = (const char *) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                mapped = (base != MAP_FAILED);
+                if (!mapped) {
+                    base = NULL;
+                } else {
+                    madvise((void *) base, size, MADV_SEQUENTIAL);
+                }
+            }
+        }
+        close(fd);
+
+        pos = base;
+        if (mapped && size >= sizeof(trace_bin_header) && !memcmp(base, TRACE_BIN_MAGIC, 4)) {
+            binary = true;
+            const trace_bin_header *header = (const trace_bin_header *) base;
+            valid = header->version == TRACE_BIN_VERSION && (header->timed != 0) == timed;
+            pos += sizeof(trace_bin_header);
+        } else {
+            valid = mapped;
+        }
+    }
+
+    ~mapped_trace_source() {
+        if (base) {
+            munmap((void *) base, size);
+        }
+    }
+
+    // The file was mapped, and has a header of the supported version and kind if binary
+    bool is_valid() const {
+        return valid;
+    }
+
+    bool next_view(trace_view &view) override {
+        if (error || !valid || pos == base + size) {
+            return false;
+        }
+        if (binary) {
+            const trace_bin_record *record = (const trace_bin_record *) pos;
+            if ((size_t) (base + size - pos) < sizeof(trace_bin_record)
+                    || (size_t) (base + size - pos - sizeof(trace_bin_record)) / sizeof(uint64_t) < record->words) {
+                error = true;       // Truncated record
+                return false;
+            }
+            view = {record->cycle, record->addr, record->wr != 0, (const uint64_t *) (record + 1), record->words};
+            pos += sizeof(trace_bin_record) + record->words * sizeof(uint64_t);
+        } else {
+            error = !parse_line(view);
+        }
+        return !error;
+    }
+
+    bool next(trace_cmd &cmd) override {
+        trace_view view;
+        if (!next_view(view)) {
+            return false;
+        }
+        cmd.cycle = view.cycle;
+        cmd.addr = view.addr;
+        cmd.wr = view.wr;
+        cmd.data.assign(view.data, view.data + view.words);
+        return true;
+    }
+
+private:
+    const char *base = NULL;
+    size_t size = 0;
+    const char *pos = NULL;     // Next command
+    bool mapped = false;
+    bool valid = false;
+    bool binary = false;
+    bool timed;                 // Text lines start with the cycle
+    std::vector<uint64_t> words;    // Payload of the last text line
+
+    // Parses a number of a text line, hexadecimal ones with or without 0x
+    static bool parse_number(const char *&p, const char *end, bool hex, uint64_t &value) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            p++;
+        }
+        if (hex && end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+            p += 2;
+        }
+        const char *start = p;
+        value = 0;
+        for (; p < end; p++) {
+            uint digit;
+            if (*p >= '0' && *p <= '9') {
+                digit = *p - '0';
+            } else if (hex && (*p | 0x20) >= 'a' && (*p | 0x20) <= 'f') {
+                digit = (*p | 0x20) - 'a' + 10;
+            } else {
+                break;
+            }
+            value = value * (hex ? 16 : 10) + digit;
+        }
+        return p != start;
+    }
+
+    // Same fields as parse_trace_cmd, without going through a stream
+    bool parse_line(trace_view &view) {
+        const char *end = (const char *) memchr(pos, '\n', base + size - pos);
+        const char *next = end ? end + 1 : base + size;
+        const char *p = pos;
+        uint64_t value;
+
+        if (!end) {
+            end = base + size;
+        }
+        pos = next;
+        view.cycle = 0;
+        if (timed && !parse_number(p, end, false, view.cycle)) {
+            return false;
+        }
+        if (!parse_number(p, end, true, view.addr)) {
+            return false;
+        }
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            p++;
+        }
+        if (p == end || *p == '\r') {
+            return false;       // No command
+        }
+        view.wr = !(end - p >= 2 && p[0] == 'R' && p[1] == 'D' && (end - p == 2 || p[2] == ' ' || p[2] == '\t' || p[2] == '\r'));
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\r') {
+            p++;
+        }
+        words.clear();
+        while (parse_number(p, end, true, value)) {
+            words.push_back(value);
+        }
+        view.data = words.data();
+        view.words = words.size();
+        return true;
+    }
+};
+
+// Checks if a trace file is binary from its first bytes
+inline bool is_bin_trace(const std::string &filename) {
+    char magic[4];
+    std::ifstream input(filename, std::ios::binary);
+    return input.read(magic, sizeof(magic)) && !memcmp(magic, TRACE_BIN_MAGIC, sizeof(magic));
+}
+
+// Opens a trace file in either format, memory-mapped unless it is not a regular
+// file. Returns NULL if it cannot be read
+inline std::unique_ptr<trace_source> open_trace_source(const std::string &filename, bool timed) {
+    std::unique_ptr<mapped_trace_source> mapped(new mapped_trace_source(filename, timed));
+    if (mapped->is_valid()) {
+        return mapped;
+    }
+    mapped.reset();
+
+    if (is_bin_trace(filename)) {
+        std::unique_ptr<bin_trace_source> source(new bin_trace_source(filename, timed));
+        if (!source->is_valid()) {
+            std::cout << "Error: binary trace " << filename << " has an unsupported version or is not a "
+                    << (timed ? "SystemC input" : "raw sequence") << std::endl;
+            return NULL;
+        }
+        return source;
+    }
+    std::unique_ptr<text_trace_source> source(new text_trace_source(filename, timed));
+    if (!source->is_open()) {
+        return NULL;
+    }
+    return source;
+}
+
+// Commands handed over by a producer running in another thread. At most capacity
+// of them are queued, the producer waits for the consumer when it is full, so
+// only a window of the trace is resident
+class queue_trace_source: public trace_source {
+public:
+    explicit queue_trace_source(size_t capacity_) : capacity(capacity_) {}
+
+    // Producer side, waits while the queue is full. Returns false once the
+    // consumer has stopped, the command is then dropped
+    bool push(trace_cmd &&cmd) {
+        std::unique_lock<std::mutex> lock(mtx);
+        notFull.wait(lock, [this]() { return queue.size() < capacity || stopped; });
+        if (stopped) {
+            return false;
+        }
+        queue.push_back(std::move(cmd));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Producer side, no more commands. With failed, the consumer sees an error
+    // after the queued ones
+    void close(bool failed = false) {
+        std::lock_guard<std::mutex> lock(mtx);
+        closed = true;
+        closeError = failed;
+        notEmpty.notify_all();
+    }
+
+    // Consumer side, no more commands are read. Releases a waiting producer
+    void stop() {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopped = true;
+        queue.clear();
+        notFull.notify_all();
+    }
+
+    bool next(trace_cmd &cmd) override {
+        std::unique_lock<std::mutex> lock(mtx);
+        notEmpty.wait(lock, [this]() { return !queue.empty() || closed; });
+        if (queue.empty()) {
+            error = error || closeError;
+            return false;
+        }
+        cmd = std::move(queue.front());
+        queue.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+private:
+    size_t capacity;
+    std::deque<trace_cmd> queue;
+    std::mutex mtx;
+    std::condition_variable notEmpty, notFull;
+    bool closed = false;        // The producer is done
+    bool closeError = false;    // The producer failed
+    bool stopped = false;       // The consumer is done
+};
+
+#endif /* SRC_TRACE_CMD_H_ */
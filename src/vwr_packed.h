@@ -0,0 +1,204 @@
+/*
+ * Copyright EPFL 2024
+ * Rafael Medina Morillas
+ *
+ * Description of a Very Wide Register (VWR) for fast simulation. Same interface
+ * and behavior as vwr, but contents are kept in 64-bit words and accessed with
+ * word granularity. Simulation only. With FAST_BUSES, the tristate ports are
+ * replaced by two-valued point-to-point input and output ports.
+ *
+ */
+
+#ifndef SRC_VWR_PACKED_H_
+#define SRC_VWR_PACKED_H_
+
+#include "systemc.h"
+
+#include <array>
+
+#include "cnm_base.h"
+#include "packed_bits.h"
+
+template<uint large_width, uint small_width, uint max_idx>
+class vwr_packed: public sc_module {
+public:
+
+    sc_in_clk                   clk;
+    sc_in<bool>                 rst;
+    sc_in<bool>                 enable; // Enable access
+    sc_in<bool>                 wr_nrd; // Write (1) or Read (0)
+    sc_in<uint>                 idx;    // Indexes the mux/demux
+    sc_in<bool>                 mask_en;// Enables using the mask
+    sc_in<uint64_t>             mask;   // Mask VWR-wide access
+    sc_in<bool>                 d_nm;   // Selects if multiplexing (0) or demultiplexing (1)
+#if FAST_BUSES
+    sc_in<packed_bv<large_width> >  lport_in;   // VWR wide write port
+    sc_out<packed_bv<large_width> > lport_out;  // VWR wide read port (zero when not reading)
+    sc_in<packed_bv<small_width> >  sport_in;   // Word wide write port
+    sc_out<packed_bv<small_width> > sport_out;  // Word wide read port (zero when not reading)
+#else
+    sc_inout_rv<large_width>    lport;  // VWR wide Read/Write port
+    sc_inout_rv<small_width>    sport;  // Word wide Read/Write port
+#endif
+
+    // Internal signals and variables
+    std::array<uint64_t, PACKED_64B(large_width)> reg;      // Register file contents
+    std::array<uint64_t, PACKED_64B(large_width)> lbus_in;  // Parsed lport when writing
+    std::array<uint64_t, PACKED_64B(small_width)> sbus_aux; // Parsed sport (in or out)
+    sc_event reg_written;   // Notified when the contents change
+    uint64_t reg_version;   // Incremented when the contents change
+
+    // Last values driven to the ports, to avoid rebuilding them when nothing changed
+#if FAST_BUSES
+    packed_bv<large_width> lbus_out;
+    packed_bv<small_width> sbus_out;
+#else
+    sc_lv<large_width> lbus_out, allzs_large;
+    sc_lv<small_width> sbus_out, allzs_small;
+#endif
+    bool ports_driven, lport_en, sport_en;
+    uint sport_idx;
+    uint64_t lport_version, sport_version;
+
+#if FAST_BUSES
+    SC_CTOR(vwr_packed) {
+#else
+    SC_CTOR(vwr_packed) : allzs_large(SC_LOGIC_Z), allzs_small(SC_LOGIC_Z) {
+#endif
+
+        SC_THREAD(clk_thread);
+        sensitive << clk.pos();
+        async_reset_signal_is(rst, false);
+
+        SC_METHOD(comb_method);
+        sensitive << reg_written << idx << enable << wr_nrd << d_nm;
+
+        reg.fill(0);
+        reg_version = 0;
+        ports_driven = lport_en = sport_en = false;
+        sport_idx = 0;
+        lport_version = sport_version = 0;
+    }
+
+    // Clocked behavior. The next value is computed directly from the ports at
+    // the clock edge, as they are stable by then (same value reg_nxt would have)
+    void clk_thread() {
+        // Reset behavior
+        reg.fill(0);
+        reg_version++;
+        reg_written.notify(SC_ZERO_TIME);
+
+        wait();
+
+        // Clocked behavior
+        while(1) {
+            if (enable->read() && wr_nrd->read()) {
+                write_next();
+                reg_version++;
+                reg_written.notify(SC_ZERO_TIME);
+            }
+
+            wait();
+        }
+    }
+
+    // Applies a write access to the contents
+    void write_next() {
+        uint i;
+
+        if (d_nm->read()) {     // Writing from the small port (demultiplex)
+            if (idx->read() < max_idx) {
+#if FAST_BUSES
+                packed_copy(reg.data(), idx->read() * small_width, sport_in->read().w, 0, small_width);
+#else
+                lv_to_packed(sport->read(), sbus_aux.data(), small_width);
+                packed_copy(reg.data(), idx->read() * small_width, sbus_aux.data(), 0, small_width);
+#endif
+            }
+        } else {                // Writing from the large port, masked by words if enabled
+#if FAST_BUSES
+            memcpy(lbus_in.data(), lport_in->read().w, sizeof(lbus_in));
+#else
+            lv_to_packed(lport->read(), lbus_in.data(), large_width);
+#endif
+            if (mask_en->read()) {
+#if FLEXIBLE_MASK
+                uint64_t mask_in = mask->read();
+#else
+                uint64_t mask_in = mask->read() ? ((uint64_t) 1 << (mask->read() - 1)) : ~(uint64_t) 0;
+#endif
+                for (i = 0; i < max_idx && i < 64; i++) {
+                    if ((mask_in >> i) & 1) {
+                        packed_copy(reg.data(), i * small_width, lbus_in.data(), i * small_width, small_width);
+                    }
+                }
+            } else {
+                reg = lbus_in;
+            }
+        }
+
+        if (max_idx*small_width < large_width) {
+            packed_clear(reg.data(), max_idx*small_width, large_width);  // The extra bits are zero (for the moment)
+        }
+    }
+
+    // Drive the tristate ports, only rebuilding the vectors when needed
+    void comb_method() {
+        bool l_en = enable->read() && !wr_nrd->read();
+        bool s_en = !d_nm->read() && !wr_nrd->read();
+        uint s_idx = (idx->read() < max_idx) ? idx->read() : 0;     // Word 0 by default
+
+        if (!ports_driven || l_en != lport_en || (l_en && lport_version != reg_version)) {
+#if FAST_BUSES
+            if (l_en) {
+                memcpy(lbus_out.w, reg.data(), sizeof(lbus_out.w));
+            } else {
+                lbus_out.clear();
+            }
+            lport_out->write(lbus_out);
+#else
+            if (l_en) {
+                packed_to_lv(reg.data(), lbus_out, large_width);
+                lport->write(lbus_out);
+            } else {
+                lport->write(allzs_large);
+            }
+#endif
+            lport_en = l_en;
+            lport_version = reg_version;
+        }
+
+        if (!ports_driven || s_en != sport_en || (s_en && (sport_version != reg_version || sport_idx != s_idx))) {
+#if FAST_BUSES
+            if (s_en) {
+                packed_copy(sbus_out.w, 0, reg.data(), s_idx * small_width, small_width);
+            } else {
+                sbus_out.clear();
+            }
+            sport_out->write(sbus_out);
+#else
+            if (s_en) {
+                packed_copy(sbus_aux.data(), 0, reg.data(), s_idx * small_width, small_width);
+                packed_to_lv(sbus_aux.data(), sbus_out, small_width);
+                sport->write(sbus_out);
+            } else {
+                sport->write(allzs_small);
+            }
+#endif
+            sport_en = s_en;
+            sport_idx = s_idx;
+            sport_version = reg_version;
+        }
+
+        ports_driven = true;
+    }
+
+    // Returns the contents as a logic vector (for debugging)
+    sc_lv<large_width> contents() const {
+        sc_lv<large_width> aux;
+        packed_to_lv(reg.data(), aux, large_width);
+        return aux;
+    }
+};
+
+#endif /* SRC_VWR_PACKED_H_ */